@@ -0,0 +1,64 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvm/manager/xaccount_state_cache.h"
+
+#include "xmetrics/xmetrics.h"
+#include "xvledger/xvaccount.h"
+
+NS_BEG2(top, contract)
+
+data::xaccount_ptr_t xtop_account_state_cache::account(common::xaccount_address_t const & address,
+                                                       observer_ptr<store::xstore_face_t> const & store,
+                                                       base::xvblockstore_t * blockstore) {
+    auto & entry = entry_of(address);
+    if (entry.account != nullptr) {
+        auto const latest = blockstore->get_latest_committed_block(address.value());
+        if (latest != nullptr && latest->get_height() == entry.account->get_chain_height()) {
+            XMETRICS_COUNTER_INCREMENT("xvm_account_state_cache_hit", 1);
+            return entry.account;
+        }
+        XMETRICS_COUNTER_INCREMENT("xvm_account_state_cache_stale", 1);
+        entry.account = nullptr;
+    }
+
+    XMETRICS_COUNTER_INCREMENT("xvm_account_state_cache_miss", 1);
+    entry.account = store->query_account(address.value());
+    return entry.account;
+}
+
+void xtop_account_state_cache::on_table_block_committed(data::xblock_ptr_t const & block) {
+    if (m_entries.empty()) {
+        return;
+    }
+
+    // the account state changes with every committed block of its table
+    auto const table_id = base::xvaccount_t{block->get_block_owner()}.get_ledger_subaddr();
+    for (auto & pair : m_entries) {
+        auto & entry = pair.second;
+        if (entry.table_id == table_id) {
+            entry.account = nullptr;
+        }
+    }
+}
+
+void xtop_account_state_cache::clear() {
+    m_entries.clear();
+}
+
+std::size_t xtop_account_state_cache::size() const noexcept {
+    return m_entries.size();
+}
+
+xtop_account_state_cache::xentry_t & xtop_account_state_cache::entry_of(common::xaccount_address_t const & address) {
+    auto it = m_entries.find(address);
+    if (it == m_entries.end()) {
+        xentry_t entry;
+        entry.table_id = base::xvaccount_t{address.value()}.get_ledger_subaddr();
+        it = m_entries.emplace(address, std::move(entry)).first;
+    }
+    return it->second;
+}
+
+NS_END2
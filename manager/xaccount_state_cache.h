@@ -0,0 +1,68 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+#include "xcommon/xaddress.h"
+#include "xdata/xblock.h"
+#include "xstore/xstore_face.h"
+#include "xvledger/xvblockstore.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+NS_BEG2(top, contract)
+
+/**
+ * @brief account state of the system contract accounts a role context sends timer transactions from.
+ *        an entry is used only while its chain height equals the latest committed height of the account
+ *        in the block store, and is reloaded from the store otherwise, so a missed committed block event
+ *        never leaves a stale nonce behind. committed table block events drop entries early.
+ *        not thread safe, owned and used by one role context.
+ */
+class xtop_account_state_cache {
+public:
+    xtop_account_state_cache() = default;
+    xtop_account_state_cache(xtop_account_state_cache const &) = delete;
+    xtop_account_state_cache & operator=(xtop_account_state_cache const &) = delete;
+    xtop_account_state_cache(xtop_account_state_cache &&) = default;
+    xtop_account_state_cache & operator=(xtop_account_state_cache &&) = default;
+    ~xtop_account_state_cache() = default;
+
+    /**
+     * @brief get the committed state of the account, nonce, last send tx hash and chain height
+     *
+     * @param address account address
+     * @param store store to load from on miss
+     * @param blockstore block store the cached entry is validated against
+     * @return data::xaccount_ptr_t nullptr if the store fails
+     */
+    data::xaccount_ptr_t account(common::xaccount_address_t const & address, observer_ptr<store::xstore_face_t> const & store, base::xvblockstore_t * blockstore);
+
+    /**
+     * @brief drop the entries of the accounts in the table of the committed table block
+     *
+     * @param block committed table block
+     */
+    void on_table_block_committed(data::xblock_ptr_t const & block);
+
+    void clear();
+
+    std::size_t size() const noexcept;
+
+private:
+    struct xentry_t {
+        uint16_t table_id{0};
+        data::xaccount_ptr_t account{};
+    };
+
+    xentry_t & entry_of(common::xaccount_address_t const & address);
+
+    std::unordered_map<common::xaccount_address_t, xentry_t> m_entries;
+};
+using xaccount_state_cache_t = xtop_account_state_cache;
+
+NS_END2
@@ -0,0 +1,184 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvm/manager/xblock_ingest_pipeline.h"
+
+#include "xbase/xcontext.h"
+#include "xbase/xlog.h"
+#include "xdata/xblock.h"
+#include "xdata/xgenesis_data.h"
+#include "xmetrics/xmetrics.h"
+
+#include <algorithm>
+#include <cassert>
+
+NS_BEG2(top, contract)
+
+constexpr std::size_t xtop_block_ingest_pipeline::default_max_pending;
+constexpr std::size_t xtop_block_ingest_pipeline::default_max_store_batch;
+constexpr std::size_t xtop_block_ingest_pipeline::timer_probe_bytes;
+
+xtop_block_ingest_pipeline::xtop_block_ingest_pipeline(xstore_handler_t store_handler,
+                                                       xschedule_handler_t schedule_store,
+                                                       std::size_t max_pending,
+                                                       std::size_t max_store_batch)
+  : m_store_handler{std::move(store_handler)}, m_schedule_store{std::move(schedule_store)}, m_max_pending{max_pending}, m_max_store_batch{std::max<std::size_t>(1, max_store_batch)} {
+    assert(m_store_handler != nullptr);
+    assert(m_schedule_store != nullptr);
+
+    m_decode_thread = std::thread{&xtop_block_ingest_pipeline::decode_loop, this};
+}
+
+xtop_block_ingest_pipeline::~xtop_block_ingest_pipeline() {
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_stopped = true;
+    }
+    m_payload_ready.notify_all();
+    m_decode_thread.join();
+
+    for (auto & decoded : m_timer_blocks) {
+        decoded.block->release_ref();
+    }
+    for (auto & decoded : m_table_blocks) {
+        decoded.block->release_ref();
+    }
+}
+
+bool xtop_block_ingest_pipeline::is_timer_payload(std::string const & payload) {
+    auto const probe_size = std::min(payload.size(), timer_probe_bytes);
+    auto const probe_end = payload.begin() + static_cast<std::ptrdiff_t>(probe_size);
+    std::string const timer_address{sys_contract_beacon_timer_addr};
+    return std::search(payload.begin(), probe_end, timer_address.begin(), timer_address.end()) != probe_end;
+}
+
+bool xtop_block_ingest_pipeline::submit(std::string payload) {
+    auto const timer = is_timer_payload(payload);
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (m_stopped) {
+            return false;
+        }
+        auto & payloads = timer ? m_timer_payloads : m_table_payloads;
+        if (payloads.size() >= m_max_pending) {
+            XMETRICS_COUNTER_INCREMENT(timer ? "xvm_block_ingest_timer_dropped" : "xvm_block_ingest_dropped", 1);
+            xwarn("[xtop_block_ingest_pipeline::submit] %s ingest queue full (%zu), broadcast block dropped", timer ? "timer" : "table", payloads.size());
+            return false;
+        }
+        payloads.push_back(xpending_payload_t{std::move(payload), std::chrono::steady_clock::now()});
+        update_depth_metrics();
+    }
+    m_payload_ready.notify_one();
+    return true;
+}
+
+void xtop_block_ingest_pipeline::decode_loop() {
+    for (;;) {
+        xpending_payload_t pending;
+        bool timer{false};
+        {
+            std::unique_lock<std::mutex> lock{m_mutex};
+            m_payload_ready.wait(lock, [this] { return m_stopped || !m_timer_payloads.empty() || !m_table_payloads.empty(); });
+            if (m_stopped) {
+                return;
+            }
+            timer = !m_timer_payloads.empty();
+            auto & payloads = timer ? m_timer_payloads : m_table_payloads;
+            pending = std::move(payloads.front());
+            payloads.pop_front();
+        }
+
+        auto const begin = std::chrono::steady_clock::now();
+        XMETRICS_COUNTER_SET("xvm_block_ingest_decode_wait_time_us", std::chrono::duration_cast<std::chrono::microseconds>(begin - pending.queued_at).count());
+
+        base::xstream_t stream(base::xcontext_t::instance(), (uint8_t *)pending.payload.data(), pending.payload.size());
+        base::xvblock_t * block = data::xblock_t::full_block_read_from(stream);
+        XMETRICS_COUNTER_SET("xvm_block_ingest_decode_time_us", std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count());
+        if (block == nullptr) {
+            xerror("contract_manager xmessage_block_broadcast_id: recv invalid data");
+            continue;
+        }
+        if (timer != (block->get_account() == sys_contract_beacon_timer_addr)) {
+            // only the lane order is affected, the decode order is still the receive order of each lane
+            XMETRICS_COUNTER_INCREMENT("xvm_block_ingest_misclassified", 1);
+            xwarn("[xtop_block_ingest_pipeline::decode_loop] block %s was queued in the %s lane", block->dump().c_str(), timer ? "timer" : "table");
+        }
+        push_decoded(block, timer);
+    }
+}
+
+void xtop_block_ingest_pipeline::push_decoded(base::xvblock_t * block, bool timer) {
+    bool schedule{false};
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        // stored in the lane it was decoded from, so blocks of one account keep their order
+        auto & queue = timer ? m_timer_blocks : m_table_blocks;
+        queue.push_back(xdecoded_block_t{block, std::chrono::steady_clock::now()});
+        update_depth_metrics();
+        if (!m_store_scheduled) {
+            m_store_scheduled = true;
+            schedule = true;
+        }
+    }
+    if (schedule) {
+        m_schedule_store();
+    }
+}
+
+void xtop_block_ingest_pipeline::store_batch() {
+    auto const begin = std::chrono::steady_clock::now();
+    std::size_t stored{0};
+    for (; stored < m_max_store_batch; ++stored) {
+        xdecoded_block_t decoded;
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            auto & queue = !m_timer_blocks.empty() ? m_timer_blocks : m_table_blocks;
+            if (queue.empty()) {
+                m_store_scheduled = false;
+                break;
+            }
+            decoded = queue.front();
+            queue.pop_front();
+            update_depth_metrics();
+        }
+
+        XMETRICS_COUNTER_SET("xvm_block_ingest_store_wait_time_us",
+                             std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - decoded.decoded_at).count());
+        m_store_handler(decoded.block);
+        decoded.block->release_ref();
+    }
+
+    if (stored > 0) {
+        XMETRICS_COUNTER_SET("xvm_block_ingest_store_batch_size", stored);
+        XMETRICS_COUNTER_SET("xvm_block_ingest_store_batch_time_us", std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count());
+    }
+
+    if (stored == m_max_store_batch) {
+        bool reschedule{false};
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (m_timer_blocks.empty() && m_table_blocks.empty()) {
+                m_store_scheduled = false;
+            } else {
+                reschedule = true;
+            }
+        }
+        // give other calls of the store thread a turn between batches
+        if (reschedule) {
+            m_schedule_store();
+        }
+    }
+}
+
+std::size_t xtop_block_ingest_pipeline::size() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_timer_payloads.size() + m_table_payloads.size() + m_timer_blocks.size() + m_table_blocks.size();
+}
+
+void xtop_block_ingest_pipeline::update_depth_metrics() const {
+    XMETRICS_COUNTER_SET("xvm_block_ingest_decode_queue_depth", m_timer_payloads.size() + m_table_payloads.size());
+    XMETRICS_COUNTER_SET("xvm_block_ingest_store_queue_depth", m_timer_blocks.size() + m_table_blocks.size());
+}
+
+NS_END2
@@ -0,0 +1,112 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+#include "xvledger/xvblock.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+NS_BEG2(top, contract)
+
+/**
+ * @brief ingest pipeline of received broadcast blocks.
+ *        payloads are decoded on one decode thread instead of the network callback thread, so blocks of an
+ *        account are stored in the order they were received. beacon timer payloads are recognized on submit
+ *        and kept in a lane of their own, which is decoded and stored before the table lane and is not
+ *        pushed out by a burst of table payloads. decoded blocks are stored in batches, one scheduled call per batch.
+ */
+class xtop_block_ingest_pipeline {
+public:
+    using xstore_handler_t = std::function<void(base::xvblock_t *)>;
+    using xschedule_handler_t = std::function<void()>;
+
+    static constexpr std::size_t default_max_pending{1024};
+    static constexpr std::size_t default_max_store_batch{32};
+    /// the account of a block is in its header, at the start of the serialized full block
+    static constexpr std::size_t timer_probe_bytes{512};
+
+    /**
+     * @brief create the pipeline and start the decode thread
+     *
+     * @param store_handler stores one decoded block, called by store_batch only
+     * @param schedule_store schedules a call of store_batch on the store thread
+     * @param max_pending upper bound of payloads of each lane waiting to be decoded, further payloads of the lane are dropped
+     * @param max_store_batch upper bound of blocks stored by one store_batch call
+     */
+    xtop_block_ingest_pipeline(xstore_handler_t store_handler,
+                               xschedule_handler_t schedule_store,
+                               std::size_t max_pending = default_max_pending,
+                               std::size_t max_store_batch = default_max_store_batch);
+    xtop_block_ingest_pipeline(xtop_block_ingest_pipeline const &) = delete;
+    xtop_block_ingest_pipeline & operator=(xtop_block_ingest_pipeline const &) = delete;
+    xtop_block_ingest_pipeline(xtop_block_ingest_pipeline &&) = delete;
+    xtop_block_ingest_pipeline & operator=(xtop_block_ingest_pipeline &&) = delete;
+    ~xtop_block_ingest_pipeline();
+
+    /**
+     * @brief queue a received payload for decoding, never blocks the caller
+     *
+     * @param payload serialized full block
+     * @return true queued
+     * @return false dropped, the pipeline is full or stopped
+     */
+    bool submit(std::string payload);
+
+    /**
+     * @brief store the next batch of decoded blocks, timer blocks first. reschedules itself while blocks remain.
+     *
+     */
+    void store_batch();
+
+    /**
+     * @brief number of payloads and decoded blocks in the pipeline
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const;
+
+private:
+    struct xpending_payload_t {
+        std::string payload;
+        std::chrono::steady_clock::time_point queued_at;
+    };
+
+    struct xdecoded_block_t {
+        base::xvblock_t * block{nullptr};  // owns one reference
+        std::chrono::steady_clock::time_point decoded_at;
+    };
+
+    static bool is_timer_payload(std::string const & payload);
+
+    void decode_loop();
+    void push_decoded(base::xvblock_t * block, bool timer);
+    void update_depth_metrics() const;
+
+    xstore_handler_t const m_store_handler;
+    xschedule_handler_t const m_schedule_store;
+    std::size_t const m_max_pending;
+    std::size_t const m_max_store_batch;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_payload_ready;
+    std::deque<xpending_payload_t> m_timer_payloads;
+    std::deque<xpending_payload_t> m_table_payloads;
+    std::deque<xdecoded_block_t> m_timer_blocks;
+    std::deque<xdecoded_block_t> m_table_blocks;
+    bool m_store_scheduled{false};
+    bool m_stopped{false};
+    std::thread m_decode_thread;
+};
+using xblock_ingest_pipeline_t = xtop_block_ingest_pipeline;
+
+NS_END2
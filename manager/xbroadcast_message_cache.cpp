@@ -0,0 +1,69 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvm/manager/xbroadcast_message_cache.h"
+
+#include "xbase/xcontext.h"
+#include "xmetrics/xmetrics.h"
+#include "xvm/manager/xmessage_ids.h"
+
+#include <cassert>
+#include <chrono>
+
+NS_BEG2(top, contract)
+
+constexpr std::size_t xtop_broadcast_message_cache::default_capacity;
+
+xtop_broadcast_message_cache::xtop_broadcast_message_cache(std::size_t capacity) : m_capacity{capacity} {
+    assert(m_capacity > 0);
+}
+
+xtop_broadcast_message_cache & xtop_broadcast_message_cache::instance() {
+    static xtop_broadcast_message_cache cache;
+    return cache;
+}
+
+std::shared_ptr<vnetwork::xmessage_t const> xtop_broadcast_message_cache::get(data::xblock_ptr_t const & block) {
+    assert(block != nullptr);
+    auto const & key = block->get_block_hash();
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        auto const it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            XMETRICS_COUNTER_INCREMENT("xvm_broadcast_message_cache_hit", 1);
+            XMETRICS_COUNTER_INCREMENT("xvm_broadcast_message_bytes_saved", it->second.payload_size);
+            XMETRICS_COUNTER_INCREMENT("xvm_broadcast_message_serialize_time_saved_us", it->second.serialize_time_us);
+            return it->second.message;
+        }
+    }
+
+    // serialize without the lock, a concurrent miss of the same block just builds an equal message
+    auto const begin = std::chrono::steady_clock::now();
+    base::xstream_t stream(base::xcontext_t::instance());
+    block->full_block_serialize_to(stream);
+    xentry_t entry;
+    entry.payload_size = static_cast<std::size_t>(stream.size());
+    entry.message = std::shared_ptr<vnetwork::xmessage_t const>{new vnetwork::xmessage_t({stream.data(), stream.data() + stream.size()}, xmessage_block_broadcast_id)};
+    entry.serialize_time_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+    XMETRICS_COUNTER_INCREMENT("xvm_broadcast_message_cache_miss", 1);
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto const result = m_entries.emplace(key, std::move(entry));
+    if (!result.second) {
+        return result.first->second.message;
+    }
+    m_order.push_back(key);
+    while (m_order.size() > m_capacity) {
+        m_entries.erase(m_order.front());
+        m_order.pop_front();
+    }
+    return result.first->second.message;
+}
+
+std::size_t xtop_broadcast_message_cache::size() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_entries.size();
+}
+
+NS_END2
@@ -0,0 +1,64 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+#include "xdata/xblock.h"
+#include "xvnetwork/xvnetwork_driver_face.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+NS_BEG2(top, contract)
+
+/**
+ * @brief cache of encoded block broadcast messages, keyed by block hash.
+ *        a block is serialized once and the same immutable message is sent to every destination group,
+ *        by every role context and for every broadcast policy.
+ */
+class xtop_broadcast_message_cache {
+public:
+    static constexpr std::size_t default_capacity{16};
+
+    explicit xtop_broadcast_message_cache(std::size_t capacity = default_capacity);
+    xtop_broadcast_message_cache(xtop_broadcast_message_cache const &) = delete;
+    xtop_broadcast_message_cache & operator=(xtop_broadcast_message_cache const &) = delete;
+    xtop_broadcast_message_cache(xtop_broadcast_message_cache &&) = delete;
+    xtop_broadcast_message_cache & operator=(xtop_broadcast_message_cache &&) = delete;
+    ~xtop_broadcast_message_cache() = default;
+
+    static xtop_broadcast_message_cache & instance();
+
+    /**
+     * @brief get the broadcast message of the block, serializing it on the first request only
+     *
+     * @param block block to broadcast
+     * @return std::shared_ptr<vnetwork::xmessage_t const> the shared message
+     */
+    std::shared_ptr<vnetwork::xmessage_t const> get(data::xblock_ptr_t const & block);
+
+    std::size_t size() const;
+
+private:
+    struct xentry_t {
+        std::shared_ptr<vnetwork::xmessage_t const> message;
+        std::size_t payload_size{0};
+        int64_t serialize_time_us{0};
+    };
+
+    std::size_t const m_capacity;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, xentry_t> m_entries;
+    std::deque<std::string> m_order;  // block hashes, oldest first
+};
+using xbroadcast_message_cache_t = xtop_broadcast_message_cache;
+
+NS_END2
@@ -0,0 +1,118 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvm/manager/xcontract_event_queue.h"
+
+#include "xbase/xlog.h"
+#include "xdata/xgenesis_data.h"
+#include "xmbus/xevent_timer.h"
+#include "xmetrics/xmetrics.h"
+
+NS_BEG2(top, contract)
+
+constexpr std::size_t xtop_contract_event_queue::default_max_block_events;
+
+static char const * const event_wait_time_metrics[] = {
+    "xvm_contract_event_vnode_wait_time_us",
+    "xvm_contract_event_timer_wait_time_us",
+    "xvm_contract_event_block_wait_time_us",
+};
+
+xtop_contract_event_queue::xtop_contract_event_queue(std::size_t max_block_events) : m_max_block_events{max_block_events} {
+}
+
+void xtop_contract_event_queue::push(mbus::xevent_ptr_t const & e, bool & schedule_drain) {
+    schedule_drain = false;
+    auto const priority = priority_of(e);
+    auto & queue = m_queues[static_cast<std::size_t>(priority)];
+
+    std::unique_lock<std::mutex> lock{m_mutex};
+    if (priority == xcontract_event_priority_t::timer && !queue.empty()) {
+        // the pending round is dropped by do_on_block once a newer one is processed, which is only safe if no context is due at it
+        auto & pending = queue.back();
+        if (timer_height(e) > timer_height(pending.event) && !timer_round_due(pending.event)) {
+            pending.event = e;
+            XMETRICS_COUNTER_INCREMENT("xvm_contract_event_coalesced", 1);
+            return;
+        }
+    }
+
+    if (priority == xcontract_event_priority_t::block && queue.size() >= m_max_block_events) {
+        // the drain thread itself must never wait for room, it is the one making room, so it goes over the bound
+        if (std::this_thread::get_id() != m_drain_thread) {
+            XMETRICS_COUNTER_INCREMENT("xvm_contract_event_producer_blocked", 1);
+            m_room_available.wait(lock, [this, &queue] { return queue.size() < m_max_block_events; });
+        }
+    }
+
+    queue.push_back(xqueued_event_t{e, std::chrono::steady_clock::now()});
+    ++m_size;
+    XMETRICS_COUNTER_SET("xvm_contract_event_queue_depth", m_size);
+    if (!m_drain_scheduled) {
+        m_drain_scheduled = true;
+        schedule_drain = true;
+    }
+}
+
+void xtop_contract_event_queue::set_next_due_timer_round(uint64_t round) noexcept {
+    m_next_due_timer_round.store(round, std::memory_order_release);
+}
+
+bool xtop_contract_event_queue::pop(mbus::xevent_ptr_t & e) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_drain_thread = std::this_thread::get_id();
+    for (std::size_t i = 0; i < static_cast<std::size_t>(xcontract_event_priority_t::count); ++i) {
+        auto & queue = m_queues[i];
+        if (queue.empty()) {
+            continue;
+        }
+
+        auto const waited = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - queue.front().queued_at).count();
+        XMETRICS_COUNTER_SET(event_wait_time_metrics[i], waited);
+        e = std::move(queue.front().event);
+        queue.pop_front();
+        --m_size;
+        XMETRICS_COUNTER_SET("xvm_contract_event_queue_depth", m_size);
+        if (i == static_cast<std::size_t>(xcontract_event_priority_t::block)) {
+            m_room_available.notify_one();
+        }
+        return true;
+    }
+
+    m_drain_scheduled = false;
+    return false;
+}
+
+std::size_t xtop_contract_event_queue::size() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_size;
+}
+
+xcontract_event_priority_t xtop_contract_event_queue::priority_of(mbus::xevent_ptr_t const & e) {
+    switch (e->major_type) {
+    case mbus::xevent_major_type_vnode:
+        return xcontract_event_priority_t::vnode;
+    case mbus::xevent_major_type_chain_timer:
+        return xcontract_event_priority_t::timer;
+    default:
+        return xcontract_event_priority_t::block;
+    }
+}
+
+uint64_t xtop_contract_event_queue::timer_height(mbus::xevent_ptr_t const & e) {
+    auto const event = dynamic_xobject_ptr_cast<mbus::xevent_chain_timer_t>(e);
+    return event != nullptr ? event->time_block->get_height() : 0;
+}
+
+bool xtop_contract_event_queue::timer_round_due(mbus::xevent_ptr_t const & e) const {
+    auto const event = dynamic_xobject_ptr_cast<mbus::xevent_chain_timer_t>(e);
+    if (event == nullptr || event->time_block->get_account() != sys_contract_beacon_timer_addr) {
+        // other timer blocks wake every context
+        return true;
+    }
+    auto const next_due = m_next_due_timer_round.load(std::memory_order_acquire);
+    return next_due == 0 || event->time_block->get_height() >= next_due;
+}
+
+NS_END2
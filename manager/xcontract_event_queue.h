@@ -0,0 +1,95 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+#include "xmbus/xevent.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+NS_BEG2(top, contract)
+
+enum class xenum_contract_event_priority : uint8_t {
+    vnode,  ///< role changes, never dropped
+    timer,  ///< chain timer, a pending round no role context is due at is replaced by a newer one
+    block,  ///< committed blocks, bounded, never dropped
+    count
+};
+using xcontract_event_priority_t = xenum_contract_event_priority;
+
+/**
+ * @brief event queue of the contract manager.
+ *        vnode and timer events are taken before committed block events. a pending beacon timer event
+ *        is replaced by a newer one only if no role context is due at its round, so no due contract call
+ *        is skipped. block events are bounded: a producer blocks until there is room, no event is dropped.
+ */
+class xtop_contract_event_queue {
+public:
+    static constexpr std::size_t default_max_block_events{4096};
+
+    explicit xtop_contract_event_queue(std::size_t max_block_events = default_max_block_events);
+    xtop_contract_event_queue(xtop_contract_event_queue const &) = delete;
+    xtop_contract_event_queue & operator=(xtop_contract_event_queue const &) = delete;
+    xtop_contract_event_queue(xtop_contract_event_queue &&) = delete;
+    xtop_contract_event_queue & operator=(xtop_contract_event_queue &&) = delete;
+    ~xtop_contract_event_queue() = default;
+
+    /**
+     * @brief queue the event, blocks while the block events are at their bound
+     *
+     * @param e event ptr
+     * @param schedule_drain set to true if the caller must schedule a drain, i.e. no drain is pending
+     */
+    void push(mbus::xevent_ptr_t const & e, bool & schedule_drain);
+
+    /**
+     * @brief publish the first timer round a role context is due at, set by the drain after each event.
+     *        0 means unknown, then every timer round is treated as due.
+     *
+     * @param round the first due round
+     */
+    void set_next_due_timer_round(uint64_t round) noexcept;
+
+    /**
+     * @brief take the event with the highest priority, called by the drain only
+     *
+     * @param e event ptr to store to
+     * @return true an event is taken
+     * @return false the queue is empty and the pending drain is finished
+     */
+    bool pop(mbus::xevent_ptr_t & e);
+
+    std::size_t size() const;
+
+private:
+    struct xqueued_event_t {
+        mbus::xevent_ptr_t event;
+        std::chrono::steady_clock::time_point queued_at;
+    };
+
+    static xcontract_event_priority_t priority_of(mbus::xevent_ptr_t const & e);
+    static uint64_t timer_height(mbus::xevent_ptr_t const & e);
+    bool timer_round_due(mbus::xevent_ptr_t const & e) const;
+
+    std::size_t const m_max_block_events;
+    std::atomic<uint64_t> m_next_due_timer_round{0};
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_room_available;
+    std::deque<xqueued_event_t> m_queues[static_cast<std::size_t>(xcontract_event_priority_t::count)];
+    std::size_t m_size{0};
+    bool m_drain_scheduled{false};
+    std::thread::id m_drain_thread{};
+};
+using xcontract_event_queue_t = xtop_contract_event_queue;
+
+NS_END2
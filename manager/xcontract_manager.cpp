@@ -34,6 +34,7 @@
 #include "xvm/xsystem_contracts/xelection/xzec/xzec_group_association_contract.h"
 #include "xvm/xsystem_contracts/xelection/xzec/xzec_standby_pool_contract.h"
 #include "xvm/xsystem_contracts/xregistration/xrec_registration_contract.h"
+#include "xvm/xsystem_contracts/xregistration/xreg_node_decoder.h"
 #include "xvm/xsystem_contracts/xreward/xtable_reward_claiming_contract.h"
 #include "xvm/xsystem_contracts/xreward/xtable_vote_contract.h"
 #include "xvm/xsystem_contracts/xreward/xzec_reward_contract.h"
@@ -43,7 +44,14 @@
 #include "xvm/xsystem_contracts/xworkload/xzec_workload_contract_v2.h"
 #include "xvm/xvm_service.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cinttypes>
+#include <exception>
+#include <functional>
+#include <system_error>
+#include <thread>
 
 using namespace top::base;
 using namespace top::mbus;
@@ -53,6 +61,67 @@ using namespace top::store;
 
 NS_BEG2(top, contract)
 
+static constexpr std::size_t setup_chain_max_workers{8};
+static constexpr std::size_t max_events_per_drain{64};
+
+/**
+ * @brief joins the threads on scope exit, a joinable std::thread destroyed unjoined terminates the process
+ */
+class xthread_joiner_t {
+public:
+    explicit xthread_joiner_t(std::vector<std::thread> & threads) : m_threads{threads} {
+    }
+    xthread_joiner_t(xthread_joiner_t const &) = delete;
+    xthread_joiner_t & operator=(xthread_joiner_t const &) = delete;
+    ~xthread_joiner_t() {
+        for (auto & t : m_threads) {
+            if (t.joinable()) {
+                t.join();
+            }
+        }
+    }
+
+private:
+    std::vector<std::thread> & m_threads;
+};
+
+/**
+ * @brief run task(i) for every i in [0, count) on at most max_workers threads, the calling thread included, then join.
+ *        only used by the genesis setup at startup. tasks must only write their own slot so the result does not
+ *        depend on scheduling. errors[i] holds the exception of task i. if a thread cannot be started, the tasks
+ *        are run by the threads already started and the calling thread.
+ */
+static std::size_t parallel_for(std::size_t count, std::size_t max_workers, std::function<void(std::size_t)> const & task, std::vector<std::exception_ptr> & errors) {
+    errors.assign(count, nullptr);
+    std::atomic<std::size_t> next_task{0};
+    auto const worker = [&] {
+        for (auto i = next_task++; i < count; i = next_task++) {
+            try {
+                task(i);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    auto const hardware_threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    auto const worker_count = std::max<std::size_t>(1, std::min({hardware_threads, max_workers, count}));
+    std::vector<std::thread> workers;
+    xthread_joiner_t const joiner{workers};
+    try {
+        workers.reserve(worker_count - 1);
+        for (std::size_t i = 1; i < worker_count; ++i) {
+            workers.emplace_back(worker);
+        }
+    } catch (std::system_error const & e) {
+        xwarn("[parallel_for] started %zu of %zu workers: %s", workers.size(), worker_count - 1, e.what());
+    } catch (std::bad_alloc const & e) {
+        xwarn("[parallel_for] started %zu of %zu workers: %s", workers.size(), worker_count - 1, e.what());
+    }
+    worker();
+    return workers.size() + 1;
+}
+
 xtop_contract_manager & xtop_contract_manager::instance() {
     static xtop_contract_manager * inst = new xtop_contract_manager();
     return *inst;
@@ -92,29 +161,46 @@ void xtop_contract_manager::instantiate_sys_contracts() {
 #undef XREGISTER_CONTRACT
 
 void xtop_contract_manager::setup_blockchains(xvblockstore_t * blockstore) {
+    XMETRICS_TIME_RECORD("xvm_setup_blockchains_time");
+    auto const begin = std::chrono::steady_clock::now();
+
     // setup all contracts' accounts, then no need
     // sync generation block at all
+    // contracts are set up one after another in deploy order, only the tables of one contract run in parallel.
+    // a chain whose genesis block already exists is not set up again.
+    bool all_succ{true};
     for (auto const & pair : xcontract_deploy_t::instance().get_map()) {
         if (data::is_sys_sharding_contract_address(pair.first)) {
+            std::vector<common::xaccount_address_t> table_addresses;
+            table_addresses.reserve(enum_vbucket_has_tables_count);
             for (auto i = 0; i < enum_vbucket_has_tables_count; i++) {
-                auto addr = data::make_address_by_prefix_and_subaddr(pair.first.value(), i);
-                register_contract_cluster_address(pair.first, addr);
-                setup_chain(addr, blockstore);
+                table_addresses.push_back(data::make_address_by_prefix_and_subaddr(pair.first.value(), i));
             }
+            register_contract_cluster_addresses(pair.first, table_addresses);
+            all_succ = setup_chains(pair.first, table_addresses, blockstore) && all_succ;
         } else {
             register_contract_cluster_address(pair.first, pair.first);
-            setup_chain(pair.first, blockstore);
+            XMETRICS_TIME_RECORD("xvm_setup_chain_time");
+            auto const chain_begin = std::chrono::steady_clock::now();
+            all_succ = setup_chain(pair.first, blockstore) && all_succ;
+            auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - chain_begin).count();
+            xdbg("[xtop_contract_manager::setup_blockchains] chain %s, time %" PRId64 "ms", pair.first.c_str(), static_cast<int64_t>(elapsed));
         }
     }
+
+    auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+    xkinfo("[xtop_contract_manager::setup_blockchains] %s, time %" PRId64 "ms", all_succ ? "SUCC" : "FAIL", static_cast<int64_t>(elapsed));
 }
 
 void xtop_contract_manager::register_address() {
     for (auto const & pair : xcontract_deploy_t::instance().get_map()) {
         if (data::is_sys_sharding_contract_address(pair.first)) {
+            std::vector<common::xaccount_address_t> table_addresses;
+            table_addresses.reserve(enum_vbucket_has_tables_count);
             for (auto i = 0; i < enum_vbucket_has_tables_count; i++) {
-                auto addr = data::make_address_by_prefix_and_subaddr(pair.first.value(), i);
-                register_contract_cluster_address(pair.first, addr);
+                table_addresses.push_back(data::make_address_by_prefix_and_subaddr(pair.first.value(), i));
             }
+            register_contract_cluster_addresses(pair.first, table_addresses);
         } else {
             register_contract_cluster_address(pair.first, pair.first);
         }
@@ -124,12 +210,7 @@ void xtop_contract_manager::register_address() {
 xcontract_base * xtop_contract_manager::get_contract(common::xaccount_address_t const & address) {
     xcontract_base * pc{};
     if (data::is_sys_contract_address(address)) {  // by cluster address
-        m_rwlock.lock_read();
-        auto it = m_contract_inst_map.find(address);
-        if (it != m_contract_inst_map.end()) {
-            pc = it->second;
-        }
-        m_rwlock.release_read();
+        pc = m_contract_inst_map.find(address);
     } else {
         pc = m_contract_register.get_contract(address);  // by name
     }
@@ -140,43 +221,44 @@ void xtop_contract_manager::install_monitors(observer_ptr<xmessage_bus_face_t> c
                                              observer_ptr<vnetwork::xmessage_callback_hub_t> const & msg_callback_hub,
                                              observer_ptr<xstore_face_t> const & store,
                                              xobject_ptr_t<store::xsyncvstore_t> const & syncstore) {
-    msg_callback_hub->register_message_ready_notify([this, nid = msg_callback_hub->network_id(), bus_ptr = bus.get()](xvnode_address_t const &, xmessage_t const & msg, std::uint64_t const) {
-        if (msg.id() == xmessage_block_broadcast_id) {
-            base::xstream_t stream(base::xcontext_t::instance(), (uint8_t *)msg.payload().data(), msg.payload().size());
-            base::xauto_ptr<xvblock_t> block(data::xblock_t::full_block_read_from(stream));
-            if (block != nullptr) {
-                auto store_block = [this, bus_ptr](top::base::xcall_t & call,const int32_t thread_id, const uint64_t time_now_ms)->bool
-                {
-                    base::xvblock_t * block = dynamic_cast<base::xvblock_t*>(call.get_param1().get_object());
-                    //xcontract_manager_t * contract_manager = reinterpret_cast<contract::xcontract_manager_t*>(call.get_param2().get_object());
-                    bool succ = this->m_syncstore->store_block(block);
-                    xinfo("contract manager sees: received broadcast block=%s save %s",
-                          block->dump().c_str(),
-                          succ ? "SUCC" : "FAIL");
-                    if (block->get_account() == sys_contract_beacon_timer_addr) {
-                        if (!succ) {
-                            // don't know why save failed, verify...
-                            block->reset_block_flags();
-                            auto succ = this->m_syncstore->get_vcertauth()->verify_muti_sign(block) == base::enum_vcert_auth_result::enum_successful;
-                            if (succ) {
-                                block->set_block_flag(base::enum_xvblock_flag_authenticated);
-                            }
-                        }
-                        if (succ) {
-                            auto event_ptr = make_object_ptr<xevent_chain_timer_t>(block);
-                            bus_ptr->push_event(event_ptr);
-                            xdbg("[xtop_contract_manager::install_monitors] push event");
-                            XMETRICS_GAUGE_SET_VALUE(metrics::clock_received_height, block->get_height());
-                        }
+    if (m_block_ingest == nullptr) {
+        auto store_block = [this, bus_ptr = bus.get()](base::xvblock_t * block) {
+            bool succ = this->m_syncstore->store_block(block);
+            xinfo("contract manager sees: received broadcast block=%s save %s",
+                  block->dump().c_str(),
+                  succ ? "SUCC" : "FAIL");
+            if (block->get_account() == sys_contract_beacon_timer_addr) {
+                if (!succ) {
+                    // don't know why save failed, verify...
+                    block->reset_block_flags();
+                    auto succ = this->m_syncstore->get_vcertauth()->verify_muti_sign(block) == base::enum_vcert_auth_result::enum_successful;
+                    if (succ) {
+                        block->set_block_flag(base::enum_xvblock_flag_authenticated);
                     }
-                    return true;
-                };
-
-                base::xcall_t asyn_call(store_block, (base::xobject_t*)block.get());
-                get_thread()->send_call(asyn_call);
-            } else {
-                xerror("contract_manager xmessage_block_broadcast_id: recv invalid data");
+                }
+                if (succ) {
+                    auto event_ptr = make_object_ptr<xevent_chain_timer_t>(block);
+                    bus_ptr->push_event(event_ptr);
+                    xdbg("[xtop_contract_manager::install_monitors] push event");
+                    XMETRICS_GAUGE_SET_VALUE(metrics::clock_received_height, block->get_height());
+                }
             }
+        };
+        auto schedule_store = [this] {
+            auto store_batch = [this](base::xcall_t &, const int32_t, const uint64_t) -> bool {
+                m_block_ingest->store_batch();
+                return true;
+            };
+            base::xcall_t store_call(store_batch);
+            get_thread()->send_call(store_call);
+        };
+        m_block_ingest.reset(new xblock_ingest_pipeline_t{store_block, schedule_store});
+    }
+
+    msg_callback_hub->register_message_ready_notify([this](xvnode_address_t const &, xmessage_t const & msg, std::uint64_t const) {
+        if (msg.id() == xmessage_block_broadcast_id) {
+            // decoded and stored by the ingest pipeline, keep the network callback thread free
+            m_block_ingest->submit(std::string{reinterpret_cast<char const *>(msg.payload().data()), msg.payload().size()});
         }
     });
 
@@ -189,6 +271,7 @@ void xtop_contract_manager::clear() {
         delete pair.second;
     }
     m_map.clear();
+    m_timer_scheduler.invalidate();
 
     m_contract_inst_map.clear();
 }
@@ -206,6 +289,42 @@ bool xtop_contract_manager::filter_event(const xevent_ptr_t & e) {
     }
 }
 
+void xtop_contract_manager::push_event(const xevent_ptr_t & e) {
+    if (!filter_event(e)) {
+        return;
+    }
+
+    bool need_drain{false};
+    m_event_queue.push(e, need_drain);
+    if (need_drain) {
+        schedule_drain();
+    }
+    after_event_pushed(e);
+}
+
+void xtop_contract_manager::schedule_drain() {
+    auto drain = [this](base::xcall_t &, const int32_t, const uint64_t) -> bool {
+        drain_events();
+        return true;
+    };
+    base::xcall_t drain_call(drain);
+    get_thread()->send_call(drain_call);
+}
+
+void xtop_contract_manager::drain_events() {
+    xevent_ptr_t e;
+    for (std::size_t i = 0; i < max_events_per_drain; ++i) {
+        if (!m_event_queue.pop(e)) {
+            return;
+        }
+        process_event(e);
+        // contexts may have been added or removed, an invalid index means every timer round counts as due
+        m_event_queue.set_next_due_timer_round(m_timer_scheduler.valid() ? m_timer_scheduler.next_due_round() : 0);
+    }
+    // give other calls on the thread a turn, the drain stays scheduled
+    schedule_drain();
+}
+
 void xtop_contract_manager::after_event_pushed(const xevent_ptr_t & e) {
     if (e->major_type == xevent_major_type_vnode) {
         ((xevent_vnode_t *)e.get())->wait();  // wait till event processed
@@ -252,6 +371,7 @@ void xtop_contract_manager::do_destory_vnode(const xevent_vnode_ptr_t & e) {
             ++it;
         }
     }
+    m_timer_scheduler.invalidate();
 }
 
 void xtop_contract_manager::do_on_block(const xevent_ptr_t & e) {
@@ -266,11 +386,32 @@ void xtop_contract_manager::do_on_block(const xevent_ptr_t & e) {
 
         m_latest_timer = height;  // record
         xdbg("[xtop_contract_manager::do_on_block] on timer block=%s, map size %d", event->time_block->dump().c_str(), m_map.size());
-        for (auto & pair : m_map) { // m_map : std::unordered_map<common::xaccount_address_t, xrole_map_t *>
-            for (auto & pr : *(pair.second)) {  // using xrole_map_t = std::unordered_map<xvnetwork_driver_face_t *, xrole_context_t *>;
-                pr.second->on_block_timer(e);
+        if (event->time_block->get_account() != sys_contract_beacon_timer_addr) {
+            for (auto & pair : m_map) { // m_map : std::unordered_map<common::xaccount_address_t, xrole_map_t *>
+                for (auto & pr : *(pair.second)) {  // using xrole_map_t = std::unordered_map<xvnetwork_driver_face_t *, xrole_context_t *>;
+                    pr.second->on_block_timer(e);
+                }
+            }
+            return;
+        }
+
+        if (!m_timer_scheduler.valid()) {
+            std::vector<xrole_context_t *> contexts;
+            for (auto & pair : m_map) {
+                for (auto & pr : *(pair.second)) {
+                    contexts.push_back(pr.second);
+                }
             }
+            m_timer_scheduler.rebuild(contexts, height);
         }
+        auto const due_contexts = m_timer_scheduler.due(height);
+        for (auto * rc : due_contexts) {
+            rc->on_block_timer(e);
+        }
+        auto const skipped = m_timer_scheduler.size() - due_contexts.size();
+        XMETRICS_COUNTER_SET("xvm_timer_contexts_woken", due_contexts.size());
+        XMETRICS_COUNTER_SET("xvm_timer_contexts_skipped", skipped);
+        xdbg("[xtop_contract_manager::do_on_block] timer %" PRIu64 ", woken %zu, skipped %zu", height, due_contexts.size(), skipped);
     } else if (e->major_type == xevent_major_type_store && e->minor_type == xevent_store_t::type_block_committed) {
         // TODO(jimmy) check if need process firstly
         xevent_store_block_committed_ptr_t store_event = dynamic_xobject_ptr_cast<xevent_store_block_committed_t>(e);
@@ -284,12 +425,28 @@ void xtop_contract_manager::do_on_block(const xevent_ptr_t & e) {
             return;
         }
         xdbg("[xtop_contract_manager::do_on_block] on block to db, block=%s, map size %d", block->dump().c_str(), m_map.size());
-        bool event_broadcasted{false};
-        for (auto & pair : m_map) { // m_map : std::unordered_map<common::xaccount_address_t, xrole_map_t *>
-            // auto const & account_address = top::get<common::xaccount_address_t const>(pair);
-            for (auto & pr : *(pair.second)) {  // using xrole_map_t = std::unordered_map<xvnetwork_driver_face_t *, xrole_context_t *>;
-                pr.second->on_block_to_db(block, event_broadcasted);
+        dispatch_block_to_db(block);
+    }
+}
+
+void xtop_contract_manager::dispatch_block_to_db(const xblock_ptr_t & block) {
+    // the full block is loaded at most once and shared by the contexts needing it, the contexts run in map order as before
+    base::xauto_ptr<base::xvblock_t> full_block{nullptr};
+    bool event_broadcasted{false};
+    for (auto & pair : m_map) {  // m_map : std::unordered_map<common::xaccount_address_t, xrole_map_t *>
+        for (auto & pr : *(pair.second)) {  // using xrole_map_t = std::unordered_map<xvnetwork_driver_face_t *, xrole_context_t *>;
+            auto * rc = pr.second;
+            rc->on_block_committed(block);
+            if (rc->needs_full_block(block)) {
+                if (full_block == nullptr) {
+                    full_block = xrole_context_t::load_full_block(block);
+                }
+                XMETRICS_TIME_RECORD("xvm_role_context_block_monitor_time");
+                rc->on_block_monitors(block, full_block.get());
             }
+
+            XMETRICS_TIME_RECORD("xvm_role_context_block_broadcast_time");
+            rc->on_block_broadcasts(block, event_broadcasted);
         }
     }
 }
@@ -343,6 +500,7 @@ void xtop_contract_manager::add_to_map(xrole_map_t & m, xrole_context_t * rc, xv
     }
 
     m[driver] = rc;
+    m_timer_scheduler.invalidate();
 }
 
 void xtop_contract_manager::init(observer_ptr<xstore_face_t> const & store,
@@ -351,12 +509,60 @@ void xtop_contract_manager::init(observer_ptr<xstore_face_t> const & store,
     m_syncstore = make_observer(syncstore.get());
 }
 
-void xtop_contract_manager::setup_chain(common::xaccount_address_t const & contract_cluster_address, xvblockstore_t * blockstore) {
+bool xtop_contract_manager::setup_chain(common::xaccount_address_t const & contract_cluster_address, xvblockstore_t * blockstore) {
+    auto * block = make_genesis_block(contract_cluster_address, blockstore);
+    if (block == nullptr) {
+        return true;
+    }
+    return store_genesis_block(contract_cluster_address, block, blockstore);
+}
+
+bool xtop_contract_manager::setup_chains(common::xaccount_address_t const & contract_address,
+                                         std::vector<common::xaccount_address_t> const & contract_cluster_addresses,
+                                         xvblockstore_t * blockstore) {
+    XMETRICS_TIME_RECORD("xvm_setup_chains_time");
+    auto const begin = std::chrono::steady_clock::now();
+
+    auto const task_count = contract_cluster_addresses.size();
+    std::vector<base::xvblock_t *> blocks(task_count, nullptr);
+    std::vector<std::exception_ptr> errors;
+    auto const worker_count = parallel_for(task_count, setup_chain_max_workers, [&](std::size_t i) {
+        blocks[i] = make_genesis_block(contract_cluster_addresses[i], blockstore);
+    }, errors);
+
+    // store in table order, as the serial setup did: the tables before the first failed one are stored, the rest released
+    bool all_succ{true};
+    std::exception_ptr first_error;
+    for (std::size_t i = 0; i < task_count; ++i) {
+        if (errors[i] != nullptr && first_error == nullptr) {
+            first_error = errors[i];
+        }
+        if (blocks[i] == nullptr) {
+            continue;
+        }
+        if (first_error != nullptr) {
+            blocks[i]->release_ref();
+            continue;
+        }
+        all_succ = store_genesis_block(contract_cluster_addresses[i], blocks[i], blockstore) && all_succ;
+    }
+
+    auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+    xkinfo("[xtop_contract_manager::setup_chains] contract %s, tables %zu, workers %zu, time %" PRId64 "ms",
+           contract_address.c_str(), task_count, worker_count, static_cast<int64_t>(elapsed));
+
+    if (first_error != nullptr) {
+        std::rethrow_exception(first_error);
+    }
+    return all_succ;
+}
+
+base::xvblock_t * xtop_contract_manager::make_genesis_block(common::xaccount_address_t const & contract_cluster_address, xvblockstore_t * blockstore) const {
     assert(contract_cluster_address.has_value());
 
     if (blockstore->exist_genesis_block(contract_cluster_address.value())) {
         xdbg("xtop_contract_manager::setup_chain blockchain account %s genesis block exist", contract_cluster_address.c_str());
-        return;
+        return nullptr;
     }
     xdbg("xtop_contract_manager::setup_chain blockchain account %s genesis block not exist", contract_cluster_address.c_str());
 
@@ -377,29 +583,41 @@ void xtop_contract_manager::setup_chain(common::xaccount_address_t const & contr
     store::xtransaction_result_t result;
     ac.get_transaction_result(result);
 
-    base::xauto_ptr<base::xvblock_t> block(data::xblocktool_t::create_genesis_lightunit(contract_cluster_address.value(), tx, result));
+    auto * block = data::xblocktool_t::create_genesis_lightunit(contract_cluster_address.value(), tx, result);
     xassert(block);
+    return block;
+}
+
+bool xtop_contract_manager::store_genesis_block(common::xaccount_address_t const & contract_cluster_address, base::xvblock_t * genesis_block, xvblockstore_t * blockstore) {
+    base::xauto_ptr<base::xvblock_t> block(genesis_block);
 
     base::xvaccount_t _vaddr(block->get_account());
     // m_blockstore->delete_block(_vaddr, genesis_block.get());  // delete default genesis block
     auto ret = blockstore->store_block(_vaddr, block.get());
     if (!ret) {
         xerror("xtop_contract_manager::setup_chain %s genesis block fail", contract_cluster_address.c_str());
-        return;
+        return false;
     }
     xdbg("[xtop_contract_manager::setup_chain] setup %s, %s", contract_cluster_address.c_str(), ret ? "SUCC" : "FAIL");
+    return true;
 }
 
 void xtop_contract_manager::register_contract_cluster_address(common::xaccount_address_t const & address, common::xaccount_address_t const & cluster_address) {
-    m_rwlock.lock_write();
-    auto it = m_contract_inst_map.find(cluster_address);
-    if (it == m_contract_inst_map.end()) {
-        xcontract_base * pc = m_contract_register.get_contract(address);
-        if (pc != nullptr) {
-            m_contract_inst_map[cluster_address] = pc;
-        }
+    register_contract_cluster_addresses(address, {cluster_address});
+}
+
+void xtop_contract_manager::register_contract_cluster_addresses(common::xaccount_address_t const & address,
+                                                                std::vector<common::xaccount_address_t> const & cluster_addresses) {
+    xcontract_base * pc = m_contract_register.get_contract(address);
+    if (pc == nullptr) {
+        return;
     }
-    m_rwlock.release_write();
+    // one snapshot for the whole batch
+    m_contract_inst_map.update([&](contract_inst_map_t & inst_map) {
+        for (auto const & cluster_address : cluster_addresses) {
+            inst_map.emplace(cluster_address, pc);
+        }
+    });
 }
 
 base::xvnodesrv_t * xtop_contract_manager::m_nodesvr_ptr = NULL;
@@ -749,10 +967,8 @@ static void get_rec_nodes_map(observer_ptr<store::xstore_face_t const> store,
                                                  xJson::Value & json) {
     std::map<std::string, std::string> nodes;
     if ( store->map_copy_get(contract_address.value(), property_name, nodes) != 0 ) return;
-    for (auto m : nodes) {
-        xstake::xreg_node_info reg_node_info;
-        xstream_t stream(xcontext_t::instance(), (uint8_t *)m.second.data(), m.second.size());
-        reg_node_info.serialize_from(stream);
+    for (auto const & record : xstake::xreg_node_decoder_t::thread_instance().decode(nodes)) {
+        auto const & reg_node_info = record.node;
         xJson::Value j;
         j["account_addr"] = reg_node_info.m_account.value();
         j["node_deposit"] = static_cast<unsigned long long>(reg_node_info.m_account_mortgage);
@@ -787,7 +1003,7 @@ static void get_rec_nodes_map(observer_ptr<store::xstore_face_t const> store,
         j["network_id"] = network_ids;
         j["nodename"] = reg_node_info.nickname;
         j["node_sign_key"] = reg_node_info.consensus_public_key.to_string();
-        json[m.first] = j;
+        json[record.account.to_string()] = j;
     }
 }
 
@@ -1197,11 +1413,118 @@ static void get_other_map(observer_ptr<store::xstore_face_t const> store,
 }
 
 
+template <typename NodesT>
+static void emit_unqualified_nodes(NodesT const & nodes,
+                                   char const * list_name,
+                                   std::string const & property_name,
+                                   xquery_page_t const & page,
+                                   xjson_emitter_t & emitter,
+                                   bool & property_opened) {
+    bool list_opened{false};
+    std::size_t index{0};
+    for (auto const & node_data : nodes) {
+        if (!page.contains(index++)) {
+            continue;
+        }
+        if (!property_opened) {
+            emitter.key(property_name);
+            emitter.begin_object();
+            property_opened = true;
+        }
+        if (!list_opened) {
+            emitter.key(list_name);
+            emitter.begin_array();
+            list_opened = true;
+        }
+
+        auto const & unqualified_data = top::get<xnode_vote_percent_t>(node_data);
+        emitter.begin_object();
+        emitter.key("account");
+        emitter.value(top::get<common::xaccount_address_t const>(node_data).value());
+        emitter.key("block_count");
+        emitter.value(unqualified_data.block_count);
+        emitter.key("subset_count");
+        emitter.value(unqualified_data.subset_count);
+        emitter.end_object();
+    }
+    if (list_opened) {
+        emitter.end_array();
+    }
+}
+
+/**
+ * @brief emit the unqualified nodes as json[property_name]["auditor"] and json[property_name]["validator"] lists
+ */
+static void emit_unqualified_node_info(xunqualified_node_info_t const & data, std::string const & property_name, xquery_page_t const & page, xjson_emitter_t & emitter) {
+    bool property_opened{false};
+    emit_unqualified_nodes(data.auditor_info, "auditor", property_name, page, emitter, property_opened);
+    emit_unqualified_nodes(data.validator_info, "validator", property_name, page, emitter, property_opened);
+    if (property_opened) {
+        emitter.end_object();
+    }
+}
+
+/**
+ * @brief decode the cluster workloads of the workload map and emit them as the json[list_name] list
+ */
+static void emit_cluster_workloads(std::map<std::string, std::string> const & result,
+                                   char const * list_name,
+                                   xquery_page_t const & page,
+                                   xjson_emitter_t & emitter,
+                                   std::error_code & ec) {
+    bool list_opened{false};
+    std::size_t index{0};
+    for (auto const & m : result) {
+        if (!page.contains(index++)) {
+            continue;
+        }
+
+        auto const & detail = m.second;
+        base::xstream_t stream{ base::xcontext_t::instance(), reinterpret_cast<uint8_t *>(const_cast<char *>(detail.data())), static_cast<uint32_t>(detail.size()) };
+        xstake::cluster_workload_t workload;
+        try {
+            workload.serialize_from(stream);
+        } catch (top::error::xtop_error_t const & eh) {
+            ec = eh.code();
+            break;
+        } catch (enum_xerror_code const errc) {
+            ec = errc;
+            break;
+        }
+
+        auto const & key_str = workload.cluster_id;
+        common::xcluster_address_t cluster;
+        base::xstream_t key_stream{ base::xcontext_t::instance(), reinterpret_cast<uint8_t *>(const_cast<char *>(key_str.data())), static_cast<uint32_t>(key_str.size()) };
+        key_stream >> cluster;
+
+        if (!list_opened) {
+            emitter.key(list_name);
+            emitter.begin_array();
+            list_opened = true;
+        }
+        emitter.begin_object();
+        emitter.key(cluster.group_id().to_string());
+        emitter.begin_object();
+        emitter.key("cluster_total_workload");
+        emitter.value(workload.cluster_total_workload);
+        for (auto const & node : workload.m_leader_count) {
+            emitter.key(node.first);
+            emitter.value(node.second);
+        }
+        emitter.end_object();
+        emitter.end_object();
+    }
+    if (list_opened) {
+        emitter.end_array();
+    }
+}
+
 static void get_sharding_statistic_contract_property(std::string const & sharding_contract_addr,
                                                     std::string const & property_name,
                                                     uint64_t const height,
                                                     observer_ptr<store::xstore_face_t> store,
-                                                    xJson::Value & json,
+                                                    xquery_page_t const & page,
+                                                    xjson_emitter_t & emitter,
                                                     std::error_code & ec
                                                     ) {
 
@@ -1247,27 +1570,7 @@ static void get_sharding_statistic_contract_property(std::string const & shardin
             return;
         }
 
-        for (auto const & auditor_data : data.auditor_info) {
-            xJson::Value v;
-            auto const & unqualified_data = top::get<xnode_vote_percent_t>(auditor_data);
-
-            v["account"] = top::get<common::xaccount_address_t const>(auditor_data).value();
-            v["block_count"] = unqualified_data.block_count;
-            v["subset_count"] = unqualified_data.subset_count;
-
-            json[property_name]["auditor"].append(v);
-        }
-
-        for (auto const & validator_data : data.validator_info) {
-            xJson::Value v;
-            auto const & unqualified_data = top::get<xnode_vote_percent_t>(validator_data);
-
-            v["account"] = top::get<common::xaccount_address_t const>(validator_data).value();
-            v["block_count"] = unqualified_data.block_count;
-            v["subset_count"] = unqualified_data.subset_count;
-
-            json[property_name]["validator"].append(v);
-        }
+        emit_unqualified_node_info(data, property_name, page, emitter);
     } else if (property_name == xstake::XPROPERTY_CONTRACT_EXTENDED_FUNCTION_KEY) {
         auto error = store->get_map_property(sharding_contract_addr, height, property_name, result);
         if (error) {
@@ -1294,25 +1597,29 @@ static void get_sharding_statistic_contract_property(std::string const & shardin
         }
 
         uint32_t summarize_fulltableblock_count = xstring_utl::touint32(value);
-        json[property_name]["fulltableblock_count"] = summarize_fulltableblock_count;
-
+        emitter.key(property_name);
+        emitter.begin_object();
+        emitter.key("fulltableblock_count");
+        emitter.value(summarize_fulltableblock_count);
 
         it = result.find("FULLTABLE_HEIGHT");
         if (it == std::end(result)) {
             ec = xvm::enum_xvm_error_code::query_contract_data_property_missing;
+            emitter.end_object();
             return;
         }
 
         value = it->second;
         if (value.empty()) {
             ec = xvm::enum_xvm_error_code::query_contract_data_property_empty;
+            emitter.end_object();
             return;
         }
 
         uint32_t summarize_fulltableblock_height = xstring_utl::touint32(value);
-        json[property_name]["fulltableblock_height"] = summarize_fulltableblock_height;
-
-
+        emitter.key("fulltableblock_height");
+        emitter.value(summarize_fulltableblock_height);
+        emitter.end_object();
     } else if (property_name == xstake::XPORPERTY_CONTRACT_WORKLOAD_KEY) {
         auto error = store->get_map_property(sharding_contract_addr, height, property_name, result);
         if (error) {
@@ -1330,42 +1637,15 @@ static void get_sharding_statistic_contract_property(std::string const & shardin
             return;
         }
 
-        for (auto const & m : result) {
-            xJson::Value jm;
-            auto const & detail = m.second;
-            base::xstream_t stream{ base::xcontext_t::instance(), reinterpret_cast<uint8_t *>(const_cast<char *>(detail.data())), static_cast<uint32_t>(detail.size()) };
-            xstake::cluster_workload_t workload;
-            try {
-                workload.serialize_from(stream);
-            } catch (top::error::xtop_error_t const & eh) {
-                ec = eh.code();
-                return;
-            } catch (enum_xerror_code const errc) {
-                ec = errc;
-                return;
-            }
-            {
-                xJson::Value jn;
-                jn["cluster_total_workload"] = workload.cluster_total_workload;
-                auto const & key_str = workload.cluster_id;
-                common::xcluster_address_t cluster;
-                base::xstream_t key_stream{ base::xcontext_t::instance(), reinterpret_cast<uint8_t *>(const_cast<char *>(key_str.data())), static_cast<uint32_t>(key_str.size()) };
-                key_stream >> cluster;
-                for (auto const & node : workload.m_leader_count) {
-                    jn[node.first] = node.second;
-                }
-                jm[cluster.group_id().to_string()] = jn;
-            }
-            json["auditor_workload"].append(jm);
-        }
-
+        emit_cluster_workloads(result, "auditor_workload", page, emitter, ec);
     }
 }
 
 static void get_zec_slash_contract_property(std::string const & property_name,
                                             uint64_t const height,
                                             observer_ptr<store::xstore_face_t> store,
-                                            xJson::Value & json,
+                                            xquery_page_t const & page,
+                                            xjson_emitter_t & emitter,
                                             std::error_code & ec) {
     assert(!ec);
     assert(store != nullptr);
@@ -1409,27 +1689,7 @@ static void get_zec_slash_contract_property(std::string const & property_name,
             return;
         }
 
-        for (auto const & auditor_data : data.auditor_info) {
-            xJson::Value v;
-            auto const & unqualified_data = top::get<xnode_vote_percent_t>(auditor_data);
-
-            v["account"] = top::get<common::xaccount_address_t const>(auditor_data).value();
-            v["block_count"] = unqualified_data.block_count;
-            v["subset_count"] = unqualified_data.subset_count;
-
-            json[property_name]["auditor"].append(v);
-        }
-
-        for (auto const & validator_data : data.validator_info) {
-            xJson::Value v;
-            auto const & unqualified_data = top::get<xnode_vote_percent_t>(validator_data);
-
-            v["account"] = top::get<common::xaccount_address_t const>(validator_data).value();
-            v["block_count"] = unqualified_data.block_count;
-            v["subset_count"] = unqualified_data.subset_count;
-
-            json[property_name]["validator"].append(v);
-        }
+        emit_unqualified_node_info(data, property_name, page, emitter);
     } else if (property_name == xstake::XPROPERTY_CONTRACT_TABLEBLOCK_NUM_KEY) {
         auto error = store->get_map_property(sys_contract_zec_slash_info_addr, height, property_name, result);
         if (error) {
@@ -1468,11 +1728,14 @@ static void get_zec_slash_contract_property(std::string const & property_name,
             return;
         }
 
-        json[property_name]["accumulated_tableblock_count"] = summarize_tableblock_count;
+        emitter.key(property_name);
+        emitter.begin_object();
+        emitter.key("accumulated_tableblock_count");
+        emitter.value(summarize_tableblock_count);
 
-
-        // all table height
-        xJson::Value v;
+        // all table height, decoded first: a decode error leaves the list out
+        std::vector<std::pair<std::string, uint64_t>> table_heights;
+        std::size_t index{0};
         for (auto table_id = 0; table_id < enum_vledger_const::enum_vbucket_has_tables_count; ++table_id) {
             auto const it = result.find(std::to_string(table_id));
 
@@ -1485,31 +1748,49 @@ static void get_zec_slash_contract_property(std::string const & property_name,
                 continue;
             }
 
+            if (!page.contains(index++)) {
+                continue;
+            }
+
             uint64_t height;
             base::xstream_t stream{ base::xcontext_t::instance(), reinterpret_cast<uint8_t *>(const_cast<char *>(value.data())), static_cast<uint32_t>(value.size()) };
             try {
                 stream >> height;
             } catch (top::error::xtop_error_t const & eh) {
                 ec = eh.code();
+                emitter.end_object();
                 return;
             } catch (enum_xerror_code const errc) {
                 ec = errc;
+                emitter.end_object();
                 return;
             }
 
-            v[std::to_string(table_id)] = (xJson::UInt64)height;
-
+            table_heights.emplace_back(std::to_string(table_id), height);
         }
 
-        json[property_name]["table_heights"].append(v);
-
+        emitter.key("table_heights");
+        emitter.begin_array();
+        if (table_heights.empty()) {
+            emitter.null_value();
+        } else {
+            emitter.begin_object();
+            for (auto const & table_height : table_heights) {
+                emitter.key(table_height.first);
+                emitter.value(table_height.second);
+            }
+            emitter.end_object();
+        }
+        emitter.end_array();
+        emitter.end_object();
     }
 }
 
 static void get_zec_reward_contract_property(std::string const & property_name,
                                             uint64_t const height,
                                             observer_ptr<store::xstore_face_t> store,
-                                            xJson::Value & json,
+                                            xquery_page_t const & page,
+                                            xjson_emitter_t & emitter,
                                             std::error_code & ec) {
     assert(!ec);
     assert(store != nullptr);
@@ -1533,34 +1814,7 @@ static void get_zec_reward_contract_property(std::string const & property_name,
             return;
         }
 
-        for (auto const & m : result) {
-            xJson::Value jm;
-            auto const & detail = m.second;
-            base::xstream_t stream{ base::xcontext_t::instance(), reinterpret_cast<uint8_t *>(const_cast<char *>(detail.data())), static_cast<uint32_t>(detail.size()) };
-            xstake::cluster_workload_t workload;
-            try {
-                workload.serialize_from(stream);
-            } catch (top::error::xtop_error_t const & eh) {
-                ec = eh.code();
-                return;
-            } catch (enum_xerror_code const errc) {
-                ec = errc;
-                return;
-            }
-            {
-                xJson::Value jn;
-                jn["cluster_total_workload"] = workload.cluster_total_workload;
-                auto const & key_str = workload.cluster_id;
-                common::xcluster_address_t cluster;
-                base::xstream_t key_stream{ base::xcontext_t::instance(), reinterpret_cast<uint8_t *>(const_cast<char *>(key_str.data())), static_cast<uint32_t>(key_str.size()) };
-                key_stream >> cluster;
-                for (auto const & node : workload.m_leader_count) {
-                    jn[node.first] = node.second;
-                }
-                jm[cluster.group_id().to_string()] = jn;
-            }
-            json["auditor_workload"].append(jm);
-        }
+        emit_cluster_workloads(result, "auditor_workload", page, emitter, ec);
     } else if (property_name == xstake::XPORPERTY_CONTRACT_VALIDATOR_WORKLOAD_KEY) {
         auto error = store->get_map_property(sys_contract_zec_reward_addr, height, property_name, result);
         if (error) {
@@ -1578,38 +1832,120 @@ static void get_zec_reward_contract_property(std::string const & property_name,
             return;
         }
 
-        for (auto const & m : result) {
-            xJson::Value jm;
-            auto const & detail = m.second;
-            base::xstream_t stream{ base::xcontext_t::instance(), reinterpret_cast<uint8_t *>(const_cast<char *>(detail.data())), static_cast<uint32_t>(detail.size()) };
-            xstake::cluster_workload_t workload;
-            try {
-                workload.serialize_from(stream);
-            } catch (top::error::xtop_error_t const & eh) {
-                ec = eh.code();
-                return;
-            } catch (enum_xerror_code const errc) {
-                ec = errc;
-                return;
-            }
-            {
-                xJson::Value jn;
-                jn["cluster_total_workload"] = workload.cluster_total_workload;
-                auto const & key_str = workload.cluster_id;
-                common::xcluster_address_t cluster;
-                base::xstream_t key_stream{ base::xcontext_t::instance(), reinterpret_cast<uint8_t *>(const_cast<char *>(key_str.data())), static_cast<uint32_t>(key_str.size()) };
-                key_stream >> cluster;
-                for (auto const & node : workload.m_leader_count) {
-                    jn[node.first] = node.second;
-                }
-                jm[cluster.group_id().to_string()] = jn;
-            }
-            json["validator_workload"].append(jm);
-        }
+        emit_cluster_workloads(result, "validator_workload", page, emitter, ec);
+    }
+}
+
+/**
+ * @brief check if the unitstate overload of get_contract_data renders the property from the unitstate alone,
+ *        the other branches read the latest state from the store and can't be keyed by the unitstate height
+ */
+static bool renders_from_unitstate_only(common::xaccount_address_t const & contract_address, std::string const & property_name) {
+    if (contract_address == xaccount_address_t{sys_contract_zec_elect_consensus_addr} && property_name == XPROPERTY_CONTRACT_ELECTION_EXECUTED_KEY) {
+        return false;
+    }
+    if (contract_address == xaccount_address_t{sys_contract_rec_standby_pool_addr} || contract_address == xaccount_address_t{sys_contract_zec_standby_pool_addr} ||
+        contract_address == xaccount_address_t{sys_contract_zec_group_assoc_addr}) {
+        return false;
+    }
+    return property_name != PROPOSAL_MAP_ID && property_name != VOTE_MAP_ID;
+}
+
+static std::string query_cache_key(common::xaccount_address_t const & contract_address,
+                                   char const * variant,
+                                   std::string const & property_name,
+                                   xjson_format_t const json_format,
+                                   bool compatible_mode) {
+    return contract_address.value() + '/' + variant + '/' + property_name + '/' + std::to_string(static_cast<int>(json_format)) + '/' + (compatible_mode ? '1' : '0');
+}
+
+bool xtop_contract_manager::latest_committed_height(common::xaccount_address_t const & contract_address, std::uint64_t & height) const {
+    if (m_syncstore == nullptr) {
+        return false;
+    }
+    auto block = m_syncstore->get_vblockstore()->get_latest_committed_block(contract_address.value());
+    if (block == nullptr) {
+        return false;
+    }
+    height = block->get_height();
+    return true;
+}
+
+void xtop_contract_manager::query_with_cache(std::string const & cache_key,
+                                             std::uint64_t const height,
+                                             xJson::Value & json,
+                                             std::error_code & ec,
+                                             std::function<void(xJson::Value &, std::error_code &)> const & render) const {
+    if (!json.empty()) {
+        // the renderers may extend what the caller put in, only whole documents are cached
+        render(json, ec);
+        return;
+    }
+    if (m_query_cache.find(cache_key, height, json, ec)) {
+        return;
+    }
+
+    std::error_code render_ec;
+    render(json, render_ec);
+    m_query_cache.store(cache_key, height, json, render_ec);
+    if (render_ec) {
+        ec = render_ec;
     }
 }
 
 void xtop_contract_manager::get_contract_data(common::xaccount_address_t const & contract_address, xjson_format_t const json_format, bool compatible_mode, xJson::Value & json) const {
+    std::uint64_t height{0};
+    if (!latest_committed_height(contract_address, height)) {
+        return do_get_contract_data(contract_address, json_format, compatible_mode, json);
+    }
+    std::error_code ec;
+    query_with_cache(query_cache_key(contract_address, "latest", std::string{}, json_format, compatible_mode), height, json, ec, [&](xJson::Value & result, std::error_code &) {
+        do_get_contract_data(contract_address, json_format, compatible_mode, result);
+    });
+}
+
+void xtop_contract_manager::get_contract_data(common::xaccount_address_t const & contract_address,
+                                              std::uint64_t const height,
+                                              xjson_format_t const json_format,
+                                              xJson::Value & json,
+                                              std::error_code & ec) const {
+    assert(!ec);
+    query_with_cache(query_cache_key(contract_address, "height", std::string{}, json_format, false), height, json, ec, [&](xJson::Value & result, std::error_code & result_ec) {
+        do_get_contract_data(contract_address, height, json_format, result, result_ec);
+    });
+}
+
+void xtop_contract_manager::get_contract_data(common::xaccount_address_t const & contract_address,
+                                              std::string const & property_name,
+                                              xjson_format_t const json_format,
+                                              bool compatible_mode,
+                                              xJson::Value & json) const {
+    std::uint64_t height{0};
+    if (!latest_committed_height(contract_address, height)) {
+        return do_get_contract_data(contract_address, property_name, json_format, compatible_mode, json);
+    }
+    std::error_code ec;
+    query_with_cache(query_cache_key(contract_address, "latest", property_name, json_format, compatible_mode), height, json, ec, [&](xJson::Value & result, std::error_code &) {
+        do_get_contract_data(contract_address, property_name, json_format, compatible_mode, result);
+    });
+}
+
+void xtop_contract_manager::get_contract_data(common::xaccount_address_t const & contract_address,
+                                              const xaccount_ptr_t unitstate,
+                                              std::string const & property_name,
+                                              xjson_format_t const json_format,
+                                              bool compatible_mode,
+                                              xJson::Value & json) const {
+    if (unitstate == nullptr || !renders_from_unitstate_only(contract_address, property_name)) {
+        return do_get_contract_data(contract_address, unitstate, property_name, json_format, compatible_mode, json);
+    }
+    std::error_code ec;
+    query_with_cache(query_cache_key(contract_address, "unitstate", property_name, json_format, compatible_mode), unitstate->get_chain_height(), json, ec, [&](xJson::Value & result, std::error_code &) {
+        do_get_contract_data(contract_address, unitstate, property_name, json_format, compatible_mode, result);
+    });
+}
+
+void xtop_contract_manager::do_get_contract_data(common::xaccount_address_t const & contract_address, xjson_format_t const json_format, bool compatible_mode, xJson::Value & json) const {
     if (contract_address == xaccount_address_t{sys_contract_rec_elect_rec_addr} ||      // NOLINT
         contract_address == xaccount_address_t{sys_contract_rec_elect_zec_addr} ||      // NOLINT
         contract_address == xaccount_address_t{sys_contract_rec_elect_edge_addr} ||     // NOLINT
@@ -1630,25 +1966,45 @@ void xtop_contract_manager::get_contract_data(common::xaccount_address_t const &
 
 void xtop_contract_manager::get_contract_data(common::xaccount_address_t const & contract_address,
                                               std::uint64_t const height,
-                                              xjson_format_t const json_format,
-                                              xJson::Value & json,
+                                              xquery_page_t const & page,
+                                              std::string & json_text,
                                               std::error_code & ec) const {
     assert(!ec);
+    xjson_stream_emitter_t emitter{json_text};
+    emit_contract_data(contract_address, height, page, emitter, ec);
+    emitter.finish();
+}
+
+void xtop_contract_manager::do_get_contract_data(common::xaccount_address_t const & contract_address,
+                                                 std::uint64_t const height,
+                                                 xjson_format_t const json_format,
+                                                 xJson::Value & json,
+                                                 std::error_code & ec) const {
+    xjson_value_emitter_t emitter{json};
+    emit_contract_data(contract_address, height, xquery_page_t{}, emitter, ec);
+}
+
+void xtop_contract_manager::emit_contract_data(common::xaccount_address_t const & contract_address,
+                                               std::uint64_t const height,
+                                               xquery_page_t const & page,
+                                               xjson_emitter_t & emitter,
+                                               std::error_code & ec) const {
+    assert(!ec);
     if (contract_address.value().find(sys_contract_sharding_statistic_info_addr) != std::string::npos ) {
         std::error_code internal_ec;
-        get_sharding_statistic_contract_property(contract_address.value(), xstake::XPORPERTY_CONTRACT_UNQUALIFIED_NODE_KEY, height, m_store, json, internal_ec);
+        get_sharding_statistic_contract_property(contract_address.value(), xstake::XPORPERTY_CONTRACT_UNQUALIFIED_NODE_KEY, height, m_store, page, emitter, internal_ec);
         if (internal_ec) {
             xdbg("table_statistic_contract, get xstake::XPORPERTY_CONTRACT_UNQUALIFIED_NODE_KEY failed");
             ec = internal_ec;
             internal_ec.clear();
         }
-        get_sharding_statistic_contract_property(contract_address.value(), xstake::XPROPERTY_CONTRACT_EXTENDED_FUNCTION_KEY, height, m_store, json, internal_ec);
+        get_sharding_statistic_contract_property(contract_address.value(), xstake::XPROPERTY_CONTRACT_EXTENDED_FUNCTION_KEY, height, m_store, page, emitter, internal_ec);
         if (internal_ec) {
             xdbg("table_statistic_contract, get xstake::XPROPERTY_CONTRACT_EXTENDED_FUNCTION_KEY failed");
             ec = internal_ec;
             internal_ec.clear();
         }
-        get_sharding_statistic_contract_property(contract_address.value(), xstake::XPORPERTY_CONTRACT_WORKLOAD_KEY, height, m_store, json, internal_ec);
+        get_sharding_statistic_contract_property(contract_address.value(), xstake::XPORPERTY_CONTRACT_WORKLOAD_KEY, height, m_store, page, emitter, internal_ec);
         if (internal_ec) {
             xdbg("table_statistic_contract, get xstake::XPORPERTY_CONTRACT_WORKLOAD_KEY failed");
             ec = internal_ec;
@@ -1657,25 +2013,25 @@ void xtop_contract_manager::get_contract_data(common::xaccount_address_t const &
 
     } else if (contract_address == xaccount_address_t{ sys_contract_zec_slash_info_addr }) {
         std::error_code internal_ec;
-        get_zec_slash_contract_property(xstake::XPORPERTY_CONTRACT_UNQUALIFIED_NODE_KEY, height, m_store, json, internal_ec);
+        get_zec_slash_contract_property(xstake::XPORPERTY_CONTRACT_UNQUALIFIED_NODE_KEY, height, m_store, page, emitter, internal_ec);
         if (internal_ec) {
             xdbg("get xstake::XPORPERTY_CONTRACT_UNQUALIFIED_NODE_KEY failed");
             ec = internal_ec;
             internal_ec.clear();
         }
-        get_zec_slash_contract_property(xstake::XPROPERTY_CONTRACT_TABLEBLOCK_NUM_KEY, height, m_store, json, internal_ec);
+        get_zec_slash_contract_property(xstake::XPROPERTY_CONTRACT_TABLEBLOCK_NUM_KEY, height, m_store, page, emitter, internal_ec);
         if (internal_ec && !ec) {
             ec = internal_ec;
         }
     } else if (contract_address == xaccount_address_t{ sys_contract_zec_reward_addr }) {
         std::error_code internal_ec;
-        get_zec_reward_contract_property(xstake::XPORPERTY_CONTRACT_WORKLOAD_KEY, height, m_store, json, internal_ec);
+        get_zec_reward_contract_property(xstake::XPORPERTY_CONTRACT_WORKLOAD_KEY, height, m_store, page, emitter, internal_ec);
         if (internal_ec) {
             xdbg("get xstake::XPORPERTY_CONTRACT_WORKLOAD_KEY failed");
             ec = internal_ec;
             internal_ec.clear();
         }
-        get_zec_reward_contract_property(xstake::XPORPERTY_CONTRACT_VALIDATOR_WORKLOAD_KEY, height, m_store, json, internal_ec);
+        get_zec_reward_contract_property(xstake::XPORPERTY_CONTRACT_VALIDATOR_WORKLOAD_KEY, height, m_store, page, emitter, internal_ec);
         if (internal_ec && !ec) {
             xdbg("get xstake::XPORPERTY_CONTRACT_VALIDATOR_WORKLOAD_KEY failed");
             ec = internal_ec;
@@ -1683,11 +2039,11 @@ void xtop_contract_manager::get_contract_data(common::xaccount_address_t const &
     }
 }
 
-void xtop_contract_manager::get_contract_data(common::xaccount_address_t const & contract_address,
-                                              std::string const & property_name,
-                                              xjson_format_t const json_format,
-                                              bool compatible_mode,
-                                              xJson::Value & json) const {
+void xtop_contract_manager::do_get_contract_data(common::xaccount_address_t const & contract_address,
+                                                 std::string const & property_name,
+                                                 xjson_format_t const json_format,
+                                                 bool compatible_mode,
+                                                 xJson::Value & json) const {
     if (contract_address == xaccount_address_t{sys_contract_rec_elect_rec_addr} ||      // NOLINT
         contract_address == xaccount_address_t{sys_contract_rec_elect_zec_addr} ||      // NOLINT
         contract_address == xaccount_address_t{sys_contract_rec_elect_edge_addr} ||     // NOLINT
@@ -1752,10 +2108,8 @@ static void get_rec_nodes_map(common::xaccount_address_t const & contract_addres
         xdbg("[get_rec_nodes_map] contract_address: %s, property_name: %s, error", contract_address.to_string().c_str(), property_name.c_str());
         return;
     }
-    for (auto m : nodes) {
-        xstake::xreg_node_info reg_node_info;
-        xstream_t stream(xcontext_t::instance(), (uint8_t *)m.second.data(), m.second.size());
-        reg_node_info.serialize_from(stream);
+    for (auto const & record : xstake::xreg_node_decoder_t::thread_instance().decode(nodes)) {
+        auto const & reg_node_info = record.node;
         xJson::Value j;
         j["account_addr"] = reg_node_info.m_account.value();
         j["node_deposit"] = static_cast<unsigned long long>(reg_node_info.m_account_mortgage);
@@ -1790,7 +2144,7 @@ static void get_rec_nodes_map(common::xaccount_address_t const & contract_addres
         j["network_id"] = network_ids;
         j["nodename"] = reg_node_info.nickname;
         j["node_sign_key"] = reg_node_info.consensus_public_key.to_string();
-        json[m.first] = j;
+        json[record.account.to_string()] = j;
     }
 }
 
@@ -2202,12 +2556,12 @@ static void get_zec_workload_map(common::xaccount_address_t const & contract_add
 
 
 
-void xtop_contract_manager::get_contract_data(common::xaccount_address_t const & contract_address,
-                                              const xaccount_ptr_t unitstate,
-                                              std::string const & property_name,
-                                              xjson_format_t const json_format,
-                                              bool compatible_mode,
-                                              xJson::Value & json) const {
+void xtop_contract_manager::do_get_contract_data(common::xaccount_address_t const & contract_address,
+                                                 const xaccount_ptr_t unitstate,
+                                                 std::string const & property_name,
+                                                 xjson_format_t const json_format,
+                                                 bool compatible_mode,
+                                                 xJson::Value & json) const {
     if (contract_address == xaccount_address_t{sys_contract_rec_elect_rec_addr} ||      // NOLINT
         contract_address == xaccount_address_t{sys_contract_rec_elect_zec_addr} ||      // NOLINT
         contract_address == xaccount_address_t{sys_contract_rec_elect_edge_addr} ||     // NOLINT
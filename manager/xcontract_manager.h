@@ -14,13 +14,21 @@
 #include "xstore/xstore_face.h"
 #include "xvledger/xvaccount.h"
 #include "xvledger/xvcnode.h"
+#include "xvm/manager/xblock_ingest_pipeline.h"
+#include "xvm/manager/xcontract_event_queue.h"
 #include "xvm/manager/xcontract_register.h"
+#include "xvm/manager/xjson_emitter.h"
+#include "xvm/manager/xquery_result_cache.h"
 #include "xvm/manager/xrole_context.h"
+#include "xvm/manager/xsnapshot_map.h"
+#include "xvm/manager/xtimer_scheduler.h"
 #include "xvnetwork/xmessage_callback_hub.h"
 #include "xvnetwork/xvhost_face.h"
 
 #include <cstdint>
+#include <functional>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -114,6 +122,13 @@ public:
      * @param cluster_address contract cluster address
      */
     void register_contract_cluster_address(common::xaccount_address_t const & address, common::xaccount_address_t const & cluster_address);
+    /**
+     * @brief register the contract object for a batch of cluster addresses, published as one snapshot
+     *
+     * @param address contract address
+     * @param cluster_addresses contract cluster addresses
+     */
+    void register_contract_cluster_addresses(common::xaccount_address_t const & address, std::vector<common::xaccount_address_t> const & cluster_addresses);
     /**
      * @brief Get the node service object
      *
@@ -140,7 +155,7 @@ public:
      *
      * @return std::unordered_map<common::xaccount_address_t, xcontract_base *> const&
      */
-    std::unordered_map<common::xaccount_address_t, xcontract_base *> const & get_contract_inst_map() const noexcept { return m_contract_inst_map; }
+    std::unordered_map<common::xaccount_address_t, xcontract_base *> const & get_contract_inst_map() const noexcept { return m_contract_inst_map.snapshot(); }
 
     /**
      * @brief Set the nodesrv ptr object
@@ -172,6 +187,30 @@ public:
                            xJson::Value & json) const;
     void get_contract_data(common::xaccount_address_t const & contract_address, std::string const & property_name, std::string const & key, xjson_format_t const json_format, xJson::Value & json) const;
 
+    /**
+     * @brief get the contract data at height as json text, written while the properties are decoded instead of
+     *        through a json tree. map valued properties are limited to the page; with the default page the text
+     *        is byte for byte what xJson::FastWriter writes for the json overload's result.
+     *
+     * @param contract_address contract account address
+     * @param height height of the contract account
+     * @param page page of the map valued properties
+     * @param json_text text the document is appended to
+     * @param ec query error, the document is well formed but partial if set
+     */
+    void get_contract_data(common::xaccount_address_t const & contract_address,
+                           std::uint64_t const height,
+                           xquery_page_t const & page,
+                           std::string & json_text,
+                           std::error_code & ec) const;
+
+    /**
+     * @brief queue the event by priority and schedule a drain on the monitor thread
+     *
+     * @param e event prt
+     */
+    void push_event(const xevent_ptr_t & e) override;
+
 private:
     /**
      * @brief filter the event
@@ -194,6 +233,13 @@ private:
      */
     void after_event_pushed(const xevent_ptr_t & e) override;
 
+    /**
+     * @brief process queued events on the monitor thread, a bounded number per call
+     *
+     */
+    void drain_events();
+    void schedule_drain();
+
     /**
      * @brief process new vnode event
      *
@@ -212,6 +258,57 @@ private:
      * @param e event prt
      */
     void do_on_block(const xevent_ptr_t & e);
+    void do_get_contract_data(common::xaccount_address_t const & contract_address, xjson_format_t const json_format, bool compatible_mode, xJson::Value & json) const;
+    void do_get_contract_data(common::xaccount_address_t const & contract_address, std::uint64_t const height, xjson_format_t const json_format, xJson::Value & json, std::error_code & ec) const;
+    void do_get_contract_data(common::xaccount_address_t const & contract_address,
+                              std::string const & property_name,
+                              xjson_format_t const json_format,
+                              bool compatible_mode,
+                              xJson::Value & json) const;
+    void do_get_contract_data(common::xaccount_address_t const & contract_address,
+                              const xaccount_ptr_t unitstate,
+                              std::string const & property_name,
+                              xjson_format_t const json_format,
+                              bool compatible_mode,
+                              xJson::Value & json) const;
+
+    void emit_contract_data(common::xaccount_address_t const & contract_address,
+                            std::uint64_t const height,
+                            xquery_page_t const & page,
+                            xjson_emitter_t & emitter,
+                            std::error_code & ec) const;
+
+    /**
+     * @brief get the latest committed height of the contract account, the height query results are cached at
+     *
+     * @param contract_address contract account address
+     * @param height height to store to
+     * @return true found
+     * @return false no committed block, the query is not cached
+     */
+    bool latest_committed_height(common::xaccount_address_t const & contract_address, std::uint64_t & height) const;
+
+    /**
+     * @brief take the query result from the cache or render and cache it
+     *
+     * @param cache_key query key
+     * @param height height of the contract account the result belongs to
+     * @param json result
+     * @param ec query error
+     * @param render renders the result on a miss
+     */
+    void query_with_cache(std::string const & cache_key,
+                          std::uint64_t const height,
+                          xJson::Value & json,
+                          std::error_code & ec,
+                          std::function<void(xJson::Value &, std::error_code &)> const & render) const;
+    /**
+     * @brief dispatch the committed table block to all role contexts, one after another in map order.
+     *        the full table block is loaded once and shared by the contexts monitoring it.
+     *
+     * @param block committed table block
+     */
+    void dispatch_block_to_db(const xblock_ptr_t & block);
     /**
      * @brief add to map
      *
@@ -234,19 +331,56 @@ private:
      *
      * @param contract_cluster_address contract cluster address
      * @param store store
+     * @return true the chain is set up or already exists
+     */
+    bool setup_chain(common::xaccount_address_t const & contract_cluster_address, xvblockstore_t * blockstore);
+
+    /**
+     * @brief Set up the table chains of one sharding contract on a bounded worker pool.
+     *        genesis blocks are built in parallel and stored in table order afterwards.
+     *
+     * @param contract_address sharding contract address
+     * @param contract_cluster_addresses table addresses of the contract
+     * @param blockstore blockstore
+     * @return true all chains are set up
+     */
+    bool setup_chains(common::xaccount_address_t const & contract_address,
+                      std::vector<common::xaccount_address_t> const & contract_cluster_addresses,
+                      xvblockstore_t * blockstore);
+
+    /**
+     * @brief execute the setup tx of the contract and build its genesis block
+     *
+     * @param contract_cluster_address contract cluster address
+     * @param blockstore blockstore
+     * @return base::xvblock_t* genesis block owned by the caller, nullptr if it already exists
+     */
+    base::xvblock_t * make_genesis_block(common::xaccount_address_t const & contract_cluster_address, xvblockstore_t * blockstore) const;
+
+    /**
+     * @brief store the genesis block
+     *
+     * @param contract_cluster_address contract cluster address
+     * @param block genesis block, ownership is taken
+     * @param blockstore blockstore
+     * @return true the block is stored
      */
-    void setup_chain(common::xaccount_address_t const & contract_cluster_address, xvblockstore_t * blockstore);
+    bool store_genesis_block(common::xaccount_address_t const & contract_cluster_address, base::xvblock_t * block, xvblockstore_t * blockstore);
 
     std::unordered_map<common::xaccount_address_t, xrole_map_t *>    m_map;
     xcontract_register_t                                             m_contract_register;
     observer_ptr<xstore_face_t>                                      m_store{};
     observer_ptr<store::xsyncvstore_t>                               m_syncstore{};
-    std::unordered_map<common::xaccount_address_t, xcontract_base *> m_contract_inst_map;
-    base::xrwlock_t                                                  m_rwlock;
+    using contract_inst_map_t = xsnapshot_map_t<common::xaccount_address_t, xcontract_base *>::map_type;
+    xsnapshot_map_t<common::xaccount_address_t, xcontract_base *>    m_contract_inst_map;
 
     static base::xvnodesrv_t                                         *m_nodesvr_ptr;
 
     uint64_t                                                         m_latest_timer{};
+    xtimer_scheduler_t                                               m_timer_scheduler;
+    xcontract_event_queue_t                                          m_event_queue;
+    std::unique_ptr<xblock_ingest_pipeline_t>                        m_block_ingest;
+    mutable xquery_result_cache_t                                    m_query_cache;
 };
 using xcontract_manager_t = xtop_contract_manager;
 
@@ -6,7 +6,7 @@
 #include <string>
 #include <unordered_map>
 #include "xbase/xns_macro.h"
-#include "xbase/xlock.h"
+#include "xvm/manager/xsnapshot_map.h"
 #include "xvm/xcontract/xcontract_base.h"
 
 NS_BEG2(top, contract)
@@ -20,7 +20,7 @@ public:
      *
      */
     virtual ~xcontract_register_t() {
-        for(auto& pair : m_map) {
+        for(auto& pair : m_map.snapshot()) {
             delete pair.second;
         }
         m_map.clear();
@@ -37,9 +37,7 @@ public:
     void add(common::xaccount_address_t const & contract_addr, common::xnetwork_id_t const & network_id) {
         static_assert(std::is_base_of<xcontract_base, T>::value, "must subclass of xcontract_base");
 
-        m_rwlock.lock_write();
-        m_map[contract_addr]= new T{ network_id };
-        m_rwlock.release_write();
+        m_map.update([&](contract_map_t & m) { m[contract_addr] = new T{ network_id }; });
     }
 
     /**
@@ -48,20 +46,14 @@ public:
      * @param contract_addr
      * @return xcontract_base*
      */
-    xcontract_base* get_contract(common::xaccount_address_t const & contract_addr) {
-        xcontract_base* contract{};
-        m_rwlock.lock_read();
-        auto it = m_map.find(contract_addr);
-        if (it != m_map.end()) {
-            contract = it->second;
-        }
-        m_rwlock.release_read();
-        return contract;
+    xcontract_base* get_contract(common::xaccount_address_t const & contract_addr) const {
+        return m_map.find(contract_addr);
     }
 
 protected:
-    base::xrwlock_t m_rwlock;
-    std::unordered_map<common::xaccount_address_t, xcontract_base*> m_map; // key is the contract address
+    using contract_map_t = xsnapshot_map_t<common::xaccount_address_t, xcontract_base*>::map_type;
+
+    xsnapshot_map_t<common::xaccount_address_t, xcontract_base*> m_map; // key is the contract address
 };
 
 NS_END2
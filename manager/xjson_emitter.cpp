@@ -0,0 +1,278 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvm/manager/xjson_emitter.h"
+
+#include <cassert>
+#include <cstdio>
+
+NS_BEG2(top, contract)
+
+xtop_json_value_emitter::xtop_json_value_emitter(xJson::Value & root) {
+    m_containers.push_back(&root);
+}
+
+xJson::Value & xtop_json_value_emitter::slot() {
+    assert(!m_containers.empty());
+    auto & container = *m_containers.back();
+    if (container.isArray()) {
+        return container.append(xJson::Value{});
+    }
+    return container[m_key];
+}
+
+void xtop_json_value_emitter::begin_object() {
+    auto & v = slot();
+    if (v.isNull()) {
+        v = xJson::Value{xJson::objectValue};
+    }
+    m_containers.push_back(&v);
+}
+
+void xtop_json_value_emitter::end_object() {
+    assert(m_containers.size() > 1);
+    m_containers.pop_back();
+}
+
+void xtop_json_value_emitter::begin_array() {
+    auto & v = slot();
+    if (v.isNull()) {
+        v = xJson::Value{xJson::arrayValue};
+    }
+    m_containers.push_back(&v);
+}
+
+void xtop_json_value_emitter::end_array() {
+    assert(m_containers.size() > 1);
+    m_containers.pop_back();
+}
+
+void xtop_json_value_emitter::key(std::string const & name) {
+    m_key = name;
+}
+
+void xtop_json_value_emitter::value(std::string const & v) {
+    slot() = v;
+}
+
+void xtop_json_value_emitter::value(std::int32_t v) {
+    slot() = static_cast<xJson::Int>(v);
+}
+
+void xtop_json_value_emitter::value(std::uint32_t v) {
+    slot() = static_cast<xJson::UInt>(v);
+}
+
+void xtop_json_value_emitter::value(std::int64_t v) {
+    slot() = static_cast<xJson::Int64>(v);
+}
+
+void xtop_json_value_emitter::value(std::uint64_t v) {
+    slot() = static_cast<xJson::UInt64>(v);
+}
+
+void xtop_json_value_emitter::null_value() {
+    slot();
+}
+
+xtop_json_stream_emitter::xtop_json_stream_emitter(std::string & out) : m_out{out} {
+    m_root.kind = xenum_node_kind::object;
+    m_containers.push_back(&m_root);
+}
+
+xtop_json_stream_emitter::xnode_t & xtop_json_stream_emitter::member() {
+    auto & container = *m_containers.back();
+    assert(container.kind == xenum_node_kind::object);
+    auto & node = container.members[m_key];
+    if (node == nullptr) {
+        node.reset(new xnode_t{});
+    }
+    return *node;
+}
+
+void xtop_json_stream_emitter::append_element(xnode_t & array, std::string const & text) {
+    if (!array.text.empty()) {
+        array.text.push_back(',');
+    }
+    array.text += text;
+}
+
+void xtop_json_stream_emitter::begin_container(xenum_node_kind const kind) {
+    assert(!m_containers.empty());
+    auto & container = *m_containers.back();
+    if (container.kind == xenum_node_kind::array) {
+        container.open_element.reset(new xnode_t{});
+        container.open_element->kind = kind;
+        m_containers.push_back(container.open_element.get());
+        return;
+    }
+
+    // an existing container is extended, as the value emitter does
+    auto & node = member();
+    if (node.kind != kind) {
+        node = xnode_t{};
+        node.kind = kind;
+    }
+    m_containers.push_back(&node);
+}
+
+void xtop_json_stream_emitter::end_container() {
+    assert(m_containers.size() > 1);
+    m_containers.pop_back();
+    auto & container = *m_containers.back();
+    if (container.kind == xenum_node_kind::array) {
+        std::string text;
+        write(*container.open_element, text);
+        append_element(container, text);
+        container.open_element.reset();
+    }
+}
+
+void xtop_json_stream_emitter::scalar(std::string text) {
+    assert(!m_containers.empty());
+    auto & container = *m_containers.back();
+    if (container.kind == xenum_node_kind::array) {
+        append_element(container, text);
+        return;
+    }
+
+    auto & node = member();
+    node = xnode_t{};
+    node.text = std::move(text);
+}
+
+void xtop_json_stream_emitter::begin_object() {
+    begin_container(xenum_node_kind::object);
+}
+
+void xtop_json_stream_emitter::end_object() {
+    end_container();
+}
+
+void xtop_json_stream_emitter::begin_array() {
+    begin_container(xenum_node_kind::array);
+}
+
+void xtop_json_stream_emitter::end_array() {
+    end_container();
+}
+
+void xtop_json_stream_emitter::key(std::string const & name) {
+    m_key = name;
+}
+
+void xtop_json_stream_emitter::value(std::string const & v) {
+    std::string text;
+    write_string(v, text);
+    scalar(std::move(text));
+}
+
+void xtop_json_stream_emitter::value(std::int32_t v) {
+    scalar(std::to_string(v));
+}
+
+void xtop_json_stream_emitter::value(std::uint32_t v) {
+    scalar(std::to_string(v));
+}
+
+void xtop_json_stream_emitter::value(std::int64_t v) {
+    scalar(std::to_string(v));
+}
+
+void xtop_json_stream_emitter::value(std::uint64_t v) {
+    scalar(std::to_string(v));
+}
+
+void xtop_json_stream_emitter::null_value() {
+    assert(!m_containers.empty());
+    auto & container = *m_containers.back();
+    if (container.kind == xenum_node_kind::array) {
+        append_element(container, "null");
+        return;
+    }
+
+    // like xJson::Value::operator[], an existing member is kept, a new one is null
+    member();
+}
+
+void xtop_json_stream_emitter::finish() {
+    assert(m_containers.size() == 1);
+    if (m_root.members.empty()) {
+        m_out += "null";
+    } else {
+        write(m_root, m_out);
+    }
+    m_out.push_back('\n');
+}
+
+void xtop_json_stream_emitter::write(xnode_t const & node, std::string & out) {
+    switch (node.kind) {
+    case xenum_node_kind::scalar:
+        out += node.text.empty() ? std::string{"null"} : node.text;
+        break;
+    case xenum_node_kind::array:
+        out.push_back('[');
+        out += node.text;
+        out.push_back(']');
+        break;
+    case xenum_node_kind::object: {
+        // xJson orders members by key
+        out.push_back('{');
+        bool first{true};
+        for (auto const & m : node.members) {
+            if (!first) {
+                out.push_back(',');
+            }
+            first = false;
+            write_string(m.first, out);
+            out.push_back(':');
+            write(*m.second, out);
+        }
+        out.push_back('}');
+        break;
+    }
+    }
+}
+
+void xtop_json_stream_emitter::write_string(std::string const & v, std::string & out) {
+    // same escaping as valueToQuotedString of the json writers
+    out.push_back('"');
+    for (auto const c : v) {
+        switch (c) {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\b':
+            out += "\\b";
+            break;
+        case '\f':
+            out += "\\f";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buf[7];
+                std::snprintf(buf, sizeof(buf), "\\u%04X", static_cast<unsigned>(static_cast<unsigned char>(c)));
+                out += buf;
+            } else {
+                out.push_back(c);
+            }
+            break;
+        }
+    }
+    out.push_back('"');
+}
+
+NS_END2
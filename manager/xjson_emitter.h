@@ -0,0 +1,154 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "json/json.h"
+#include "xbase/xns_macro.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+NS_BEG2(top, contract)
+
+/**
+ * @brief page of the entries of a map valued property, entries outside the page are not emitted
+ */
+struct xtop_query_page {
+    std::size_t offset{0};
+    std::size_t limit{std::numeric_limits<std::size_t>::max()};
+
+    bool contains(std::size_t const index) const noexcept {
+        return index >= offset && index - offset < limit;
+    }
+};
+using xquery_page_t = xtop_query_page;
+
+/**
+ * @brief writer the contract data query helpers emit into, instead of building a json tree themselves.
+ *        calls must be balanced; a key must precede every value or container inside an object.
+ */
+class xtop_json_emitter {
+public:
+    xtop_json_emitter() = default;
+    xtop_json_emitter(xtop_json_emitter const &) = delete;
+    xtop_json_emitter & operator=(xtop_json_emitter const &) = delete;
+    xtop_json_emitter(xtop_json_emitter &&) = default;
+    xtop_json_emitter & operator=(xtop_json_emitter &&) = default;
+    virtual ~xtop_json_emitter() = default;
+
+    virtual void begin_object() = 0;
+    virtual void end_object() = 0;
+    virtual void begin_array() = 0;
+    virtual void end_array() = 0;
+    virtual void key(std::string const & name) = 0;
+
+    virtual void value(std::string const & v) = 0;
+    virtual void value(std::int32_t v) = 0;
+    virtual void value(std::uint32_t v) = 0;
+    virtual void value(std::int64_t v) = 0;
+    virtual void value(std::uint64_t v) = 0;
+    virtual void null_value() = 0;
+};
+using xjson_emitter_t = xtop_json_emitter;
+
+/**
+ * @brief emitter building an xJson::Value tree. containers emitted under an existing key are extended,
+ *        as the helpers did with json[key].append, so the tree is the one the helpers used to build.
+ */
+class xtop_json_value_emitter final : public xtop_json_emitter {
+public:
+    /**
+     * @brief emit into root, which is taken as an already open object
+     *
+     * @param root json object to emit into
+     */
+    explicit xtop_json_value_emitter(xJson::Value & root);
+
+    void begin_object() override;
+    void end_object() override;
+    void begin_array() override;
+    void end_array() override;
+    void key(std::string const & name) override;
+
+    void value(std::string const & v) override;
+    void value(std::int32_t v) override;
+    void value(std::uint32_t v) override;
+    void value(std::int64_t v) override;
+    void value(std::uint64_t v) override;
+    void null_value() override;
+
+private:
+    xJson::Value & slot();
+
+    std::vector<xJson::Value *> m_containers;
+    std::string m_key;
+};
+using xjson_value_emitter_t = xtop_json_value_emitter;
+
+/**
+ * @brief emitter writing the text xJson::FastWriter writes for the tree xjson_value_emitter_t builds, without
+ *        building that tree. array elements are written out as soon as they are complete; object members are
+ *        kept until their object is written, since the writer orders them by key and a container emitted under
+ *        an existing key is extended. like the value emitter, the root is taken as an already open object.
+ */
+class xtop_json_stream_emitter final : public xtop_json_emitter {
+public:
+    /**
+     * @brief emit into out, nothing is written before finish
+     *
+     * @param out text to append the document to
+     */
+    explicit xtop_json_stream_emitter(std::string & out);
+
+    void begin_object() override;
+    void end_object() override;
+    void begin_array() override;
+    void end_array() override;
+    void key(std::string const & name) override;
+
+    void value(std::string const & v) override;
+    void value(std::int32_t v) override;
+    void value(std::uint32_t v) override;
+    void value(std::int64_t v) override;
+    void value(std::uint64_t v) override;
+    void null_value() override;
+
+    /**
+     * @brief write the root object followed by a line feed, as FastWriter::write does. a root without members
+     *        is written as null, like an untouched xJson::Value
+     */
+    void finish();
+
+private:
+    enum class xenum_node_kind : std::uint8_t { scalar, array, object };
+
+    struct xnode_t {
+        xenum_node_kind kind{xenum_node_kind::scalar};
+        std::string text;  // a scalar, or the elements of an array written so far
+        std::map<std::string, std::unique_ptr<xnode_t>> members;
+        std::unique_ptr<xnode_t> open_element;  // container element of an array until it's complete
+    };
+
+    void begin_container(xenum_node_kind kind);
+    void end_container();
+    void scalar(std::string text);
+    xnode_t & member();
+    static void append_element(xnode_t & array, std::string const & text);
+    static void write(xnode_t const & node, std::string & out);
+    static void write_string(std::string const & v, std::string & out);
+
+    std::string & m_out;
+    xnode_t m_root;
+    std::vector<xnode_t *> m_containers;
+    std::string m_key;
+};
+using xjson_stream_emitter_t = xtop_json_stream_emitter;
+
+NS_END2
@@ -0,0 +1,63 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvm/manager/xquery_result_cache.h"
+
+#include "xmetrics/xmetrics.h"
+
+#include <cassert>
+
+NS_BEG2(top, contract)
+
+constexpr std::size_t xtop_query_result_cache::default_capacity;
+
+xtop_query_result_cache::xtop_query_result_cache(std::size_t capacity) : m_capacity{capacity} {
+    assert(m_capacity > 0);
+}
+
+bool xtop_query_result_cache::find(std::string const & key, uint64_t height, xJson::Value & json, std::error_code & ec) const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto const it = m_entries.find(key);
+    if (it == m_entries.end() || it->second.height != height) {
+        XMETRICS_COUNTER_INCREMENT("xvm_query_result_cache_miss", 1);
+        return false;
+    }
+
+    XMETRICS_COUNTER_INCREMENT("xvm_query_result_cache_hit", 1);
+    json = it->second.json;
+    ec = it->second.ec;
+    return true;
+}
+
+void xtop_query_result_cache::store(std::string const & key, uint64_t height, xJson::Value const & json, std::error_code const & ec) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        // rendered at another height, that one is outdated now
+        it->second.height = height;
+        it->second.json = json;
+        it->second.ec = ec;
+        return;
+    }
+
+    m_entries.emplace(key, xentry_t{height, json, ec});
+    m_order.push_back(key);
+    while (m_order.size() > m_capacity) {
+        m_entries.erase(m_order.front());
+        m_order.pop_front();
+    }
+}
+
+void xtop_query_result_cache::clear() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_entries.clear();
+    m_order.clear();
+}
+
+std::size_t xtop_query_result_cache::size() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_entries.size();
+}
+
+NS_END2
@@ -0,0 +1,77 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "json/json.h"
+#include "xbase/xns_macro.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+NS_BEG2(top, contract)
+
+/**
+ * @brief bounded cache of rendered contract data queries.
+ *        one entry per query, tagged with the height of the contract account it was rendered at;
+ *        a query at another height misses and replaces the entry.
+ */
+class xtop_query_result_cache {
+public:
+    static constexpr std::size_t default_capacity{256};
+
+    explicit xtop_query_result_cache(std::size_t capacity = default_capacity);
+    xtop_query_result_cache(xtop_query_result_cache const &) = delete;
+    xtop_query_result_cache & operator=(xtop_query_result_cache const &) = delete;
+    xtop_query_result_cache(xtop_query_result_cache &&) = delete;
+    xtop_query_result_cache & operator=(xtop_query_result_cache &&) = delete;
+    ~xtop_query_result_cache() = default;
+
+    /**
+     * @brief find the result of the query rendered at height
+     *
+     * @param key query key, address, property, key and format
+     * @param height height of the contract account
+     * @param json result to store to
+     * @param ec error of the query to store to
+     * @return true hit
+     * @return false miss
+     */
+    bool find(std::string const & key, uint64_t height, xJson::Value & json, std::error_code & ec) const;
+
+    /**
+     * @brief store the result of the query rendered at height
+     *
+     * @param key query key, address, property, key and format
+     * @param height height of the contract account
+     * @param json rendered result
+     * @param ec error of the query
+     */
+    void store(std::string const & key, uint64_t height, xJson::Value const & json, std::error_code const & ec);
+
+    void clear();
+
+    std::size_t size() const;
+
+private:
+    struct xentry_t {
+        uint64_t height{0};
+        xJson::Value json;
+        std::error_code ec;
+    };
+
+    std::size_t const m_capacity;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, xentry_t> m_entries;
+    std::deque<std::string> m_order;  // keys, oldest first
+};
+using xquery_result_cache_t = xtop_query_result_cache;
+
+NS_END2
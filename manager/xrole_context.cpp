@@ -7,13 +7,16 @@
 #include "xdata/xtx_factory.h"
 #include "xmbus/xevent_timer.h"
 #include "xmbus/xevent_store.h"
+#include "xvm/manager/xbroadcast_message_cache.h"
 #include "xvm/manager/xcontract_address_map.h"
-#include "xvm/manager/xmessage_ids.h"
 #include "xvm/manager/xrole_context.h"
 #include "xvm/manager/xcontract_manager.h"
+#include "xvm/xcontract/xstream_pool.h"
 #include "xvm/xvm_service.h"
 #include "xvledger/xvledger.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cinttypes>
 #include <cmath>
 
@@ -37,39 +40,63 @@ xrole_context_t::~xrole_context_t() {
 }
 
 void xrole_context_t::on_block_to_db(const xblock_ptr_t & block, bool & event_broadcasted) {
-    if (!m_contract_info->has_monitors()) {
+    on_block_committed(block);
+    on_block_monitors(block, nullptr);
+    on_block_broadcasts(block, event_broadcasted);
+}
+
+void xrole_context_t::on_block_committed(const xblock_ptr_t & block) {
+    m_account_state_cache.on_table_block_committed(block);
+}
+
+bool xrole_context_t::needs_full_block(const xblock_ptr_t & block) const {
+    return m_contract_info->has_monitors() && m_contract_info->has_block_monitors() &&
+           m_contract_info->address == common::xaccount_address_t{sys_contract_sharding_statistic_info_addr} &&
+           block->get_block_owner().find(sys_contract_sharding_table_block_addr) != std::string::npos && block->is_fulltable();
+}
+
+base::xauto_ptr<base::xvblock_t> xrole_context_t::load_full_block(const xblock_ptr_t & block) {
+    return base::xvchain_t::instance().get_xblockstore()->load_block_object(base::xvaccount_t{block->get_block_owner()}, block->get_height(), base::enum_xvblock_flag_committed, true);
+}
+
+void xrole_context_t::on_block_monitors(const xblock_ptr_t & block, base::xvblock_t * full_block) {
+    // process block event
+    // table fulltable block process
+    if (!needs_full_block(block)) {
         return;
     }
 
-    // process block event
-    if (m_contract_info->has_block_monitors()) {
-        auto block_owner = block->get_block_owner();
-        // table fulltable block process
-        if ((m_contract_info->address == common::xaccount_address_t{sys_contract_sharding_statistic_info_addr}) &&
-            block_owner.find(sys_contract_sharding_table_block_addr) != std::string::npos && block->is_fulltable()) {
-            auto block_height = block->get_height();
-            xdbg("xrole_context_t::on_block_to_db fullblock process, owner: %s, height: %" PRIu64, block->get_block_owner().c_str(), block_height);
-            base::xauto_ptr<base::xvblock_t> full_block = base::xvchain_t::instance().get_xblockstore()->load_block_object(base::xvaccount_t{block_owner}, block_height, base::enum_xvblock_flag_committed, true);
-
-            xfull_tableblock_t* full_tableblock = dynamic_cast<xfull_tableblock_t*>(full_block.get());
-            auto node_service = contract::xcontract_manager_t::instance().get_node_service();
-            auto const fulltable_statisitc_data = full_tableblock->get_table_statistics();
-            auto const statistic_accounts = fulltableblock_statistic_accounts(fulltable_statisitc_data, node_service);
-
-            base::xstream_t stream(base::xcontext_t::instance());
-            stream << fulltable_statisitc_data;
-            stream << statistic_accounts;
-            stream << block_height;
-            stream << block->get_pledge_balance_change_tgas();
-            std::string action_params = std::string((char *)stream.data(), stream.size());
-
-            xblock_monitor_info_t * info = m_contract_info->find(m_contract_info->address);
-            uint32_t table_id = 0;
-            auto result = xdatautil::extract_table_id_from_address(block_owner, table_id);
-            assert(result);
-            XMETRICS_GAUGE(metrics::xmetrics_tag_t::contract_table_fullblock_event, 1);
-            on_fulltableblock_event(m_contract_info->address, "on_collect_statistic_info", action_params, block->get_timestamp(), (uint16_t)table_id);
-        }
+    auto block_owner = block->get_block_owner();
+    auto block_height = block->get_height();
+    xdbg("xrole_context_t::on_block_to_db fullblock process, owner: %s, height: %" PRIu64, block->get_block_owner().c_str(), block_height);
+    base::xauto_ptr<base::xvblock_t> loaded_block = full_block == nullptr ? load_full_block(block) : base::xauto_ptr<base::xvblock_t>{nullptr};
+    if (full_block == nullptr) {
+        full_block = loaded_block.get();
+    }
+
+    xfull_tableblock_t* full_tableblock = dynamic_cast<xfull_tableblock_t*>(full_block);
+    auto node_service = contract::xcontract_manager_t::instance().get_node_service();
+    auto const fulltable_statisitc_data = full_tableblock->get_table_statistics();
+    auto const statistic_accounts = fulltableblock_statistic_accounts(fulltable_statisitc_data, node_service);
+
+    auto stream = xvm::xcontract::xstream_pool_t::acquire();
+    *stream << fulltable_statisitc_data;
+    *stream << statistic_accounts;
+    *stream << block_height;
+    *stream << block->get_pledge_balance_change_tgas();
+    std::string action_params = stream.to_string();
+
+    xblock_monitor_info_t * info = m_contract_info->find(m_contract_info->address);
+    uint32_t table_id = 0;
+    auto result = xdatautil::extract_table_id_from_address(block_owner, table_id);
+    assert(result);
+    XMETRICS_GAUGE(metrics::xmetrics_tag_t::contract_table_fullblock_event, 1);
+    on_fulltableblock_event(m_contract_info->address, "on_collect_statistic_info", action_params, block->get_timestamp(), (uint16_t)table_id);
+}
+
+void xrole_context_t::on_block_broadcasts(const xblock_ptr_t & block, bool & event_broadcasted) {
+    if (!m_contract_info->has_monitors()) {
+        return;
     }
 
     // process broadcasts
@@ -217,18 +244,69 @@ void xrole_context_t::on_block_timer(const xevent_ptr_t & e) {
     }
 }
 
-bool xrole_context_t::runtime_stand_alone(const uint64_t timer_round, common::xaccount_address_t const & sys_addr) const {
+static bool is_stand_alone_candidate(common::xaccount_address_t const & sys_addr) {
     static std::vector<common::xaccount_address_t> sys_addr_list{common::xaccount_address_t{sys_contract_rec_elect_edge_addr},
                                                                  common::xaccount_address_t{sys_contract_rec_elect_archive_addr},
                                                                  common::xaccount_address_t{sys_contract_rec_elect_zec_addr},
                                                                  common::xaccount_address_t{sys_contract_zec_elect_consensus_addr},
                                                                  common::xaccount_address_t{sys_contract_rec_elect_fullnode_addr}};
 
-    if (std::find(std::begin(sys_addr_list), std::end(sys_addr_list), sys_addr) == std::end(sys_addr_list)) {
+    return std::find(std::begin(sys_addr_list), std::end(sys_addr_list), sys_addr) != std::end(sys_addr_list);
+}
+
+xtimer_block_monitor_info_t * xrole_context_t::beacon_timer_monitor() const {
+    if (!m_contract_info->has_monitors() || !m_contract_info->has_block_monitors()) {
+        return nullptr;
+    }
+
+    auto const address = common::xaccount_address_t{sys_contract_beacon_timer_addr};
+    xblock_monitor_info_t * info = m_contract_info->find(address);
+    if (info == nullptr) {
+        for (auto & pair : m_contract_info->monitor_map) {
+            if (xcontract_address_map_t::match(address, pair.first)) {
+                info = pair.second;
+                break;
+            }
+        }
+    }
+    if (info == nullptr || info->type != enum_monitor_type_t::timer) {
+        return nullptr;
+    }
+    return dynamic_cast<xtimer_block_monitor_info_t *>(info);
+}
+
+uint64_t xrole_context_t::next_timer_round(const uint64_t round) const {
+    auto * timer_info = beacon_timer_monitor();
+    if (timer_info == nullptr) {
+        return xtimer_never_due;
+    }
+
+    // round 0 never calls
+    auto const from = std::max<uint64_t>(round, 1);
+    // the statistic contract advances its table schedule on every round
+    if (m_contract_info->address == common::xaccount_address_t{sys_contract_sharding_statistic_info_addr}) {
+        return from;
+    }
+
+    auto const time_interval = timer_info->get_interval();
+    if (time_interval == 0) {
+        return xtimer_never_due;
+    }
+    auto const next_multiple = [from](uint64_t const interval) { return (from + interval - 1) / interval * interval; };
+    auto due = next_multiple(time_interval);
+    // an election contract which has not produced a block yet runs every 3 rounds, see on_block_timer
+    if (is_stand_alone_candidate(m_contract_info->address)) {
+        due = std::min(due, next_multiple(3));
+    }
+    return due;
+}
+
+bool xrole_context_t::runtime_stand_alone(const uint64_t timer_round, common::xaccount_address_t const & sys_addr) const {
+    if (!is_stand_alone_candidate(sys_addr)) {
         return false;
     }
 
-    auto account = m_store->query_account(sys_addr.value());
+    auto account = m_account_state_cache.account(sys_addr, m_store, m_syncstore->get_vblockstore());
     if (nullptr == account) {
         xerror("xrole_context_t::runtime_stand_alone fail-query account.address=%s", sys_addr.value().c_str());
         xassert(nullptr != account);
@@ -292,17 +370,13 @@ data::xfulltableblock_statistic_accounts xrole_context_t::fulltableblock_statist
 }
 
 void xrole_context_t::call_contract(const uint64_t onchain_timer_round, xblock_monitor_info_t * info, const uint64_t block_timestamp) {
-    base::xstream_t stream(base::xcontext_t::instance());
-    stream << onchain_timer_round;
-    std::string action_params = std::string((char *)stream.data(), stream.size());
+    std::string action_params = xvm::xcontract::xstream_pool_t::serialize(onchain_timer_round);
 
     call_contract(action_params, block_timestamp, info);
 }
 
 void xrole_context_t:: call_contract(const uint64_t onchain_timer_round, xblock_monitor_info_t * info, const uint64_t block_timestamp, uint16_t table_id) {
-    base::xstream_t stream(base::xcontext_t::instance());
-    stream << onchain_timer_round;
-    std::string action_params = std::string((char *)stream.data(), stream.size());
+    std::string action_params = xvm::xcontract::xstream_pool_t::serialize(onchain_timer_round);
 
     call_contract(action_params, block_timestamp, info, table_id);
 }
@@ -326,41 +400,26 @@ void xrole_context_t::call_contract(const std::string & action_params, uint64_t
     } else {
         addresses.push_back(m_contract_info->address);
     }
-    xproperty_asset asset_out{0};
+
+    auto const begin = std::chrono::steady_clock::now();
+    std::vector<xself_tx_t> batch;
+    batch.reserve(addresses.size());
     for (auto & address : addresses) {
         if (is_timer_unorder(address, timestamp)) {
             xinfo("[xrole_context_t] call_contract in consensus mode, address timer unorder, not create tx", address.value().c_str());
             continue;
         }
 
-        xaccount_ptr_t account = m_store->query_account(address.value());
-        if (nullptr == account) {
-            xerror("xrole_context_t::call_contract fail-query account.address=%s", address.value().c_str());
-            xassert(nullptr != account);
-            return;
-        }
-        xtransaction_ptr_t tx = xtx_factory::create_sys_contract_call_self_tx(address.value(),
-                                                         account->account_send_trans_number(), account->account_send_trans_hash(),
-                                                         info->action, action_params, timestamp, EXPIRE_DURATION);
-
-        if (info->call_way == enum_call_action_way_t::consensus) {
-            int32_t r = m_unit_service->request_transaction_consensus(tx, true);
-            xinfo("[xrole_context_t] call_contract in consensus mode with return code : %d, %s, %s %s %ld, %lld",
-                  r,
-                  tx->get_digest_hex_str().c_str(),
-                  address.value().c_str(),
-                  data::to_hex_str(account->account_send_trans_hash()).c_str(),
-                  account->account_send_trans_number(),
-                  timestamp);
-        } else {
-            // TODO(jimmy) now support
-            xassert(false);
-            // xvm::xvm_service s;
-            // xaccount_context_t ac(address.value(), m_store.get());
-            // auto trace = s.deal_transaction(tx, &ac);
-            // xinfo("[xrole_context_t] call_contract in no_consensus mode with return code : %d", (int)trace->m_errno);
+        xself_tx_t self_tx;
+        if (!build_self_tx(address, info->action, action_params, timestamp, self_tx)) {
+            // the txs built so far are still sent, as they were when submitted one by one
+            break;
         }
+        batch.push_back(std::move(self_tx));
     }
+    XMETRICS_COUNTER_SET("xvm_self_tx_build_time_us", std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count());
+
+    submit_self_txs(batch, info, timestamp);
 }
 
 void xrole_context_t::call_contract(const std::string & action_params, uint64_t timestamp, xblock_monitor_info_t * info, uint16_t table_id) {
@@ -371,38 +430,64 @@ void xrole_context_t::call_contract(const std::string & action_params, uint64_t
         return;
     }
 
-    xaccount_ptr_t account = m_store->query_account(address.value());
+    std::vector<xself_tx_t> batch(1);
+    if (!build_self_tx(address, info->action, action_params, timestamp, batch.front())) {
+        return;
+    }
+    submit_self_txs(batch, info, timestamp);
+}
+
+bool xrole_context_t::build_self_tx(common::xaccount_address_t const & address,
+                                    std::string const & action,
+                                    std::string const & action_params,
+                                    uint64_t timestamp,
+                                    xself_tx_t & self_tx) {
+    xaccount_ptr_t account = m_account_state_cache.account(address, m_store, m_syncstore->get_vblockstore());
     if (nullptr == account) {
         xerror("xrole_context_t::call_contract fail-query account.address=%s", address.value().c_str());
         xassert(nullptr != account);
+        return false;
+    }
+    self_tx.address = address;
+    self_tx.account = account;
+    self_tx.tx = xtx_factory::create_sys_contract_call_self_tx(address.value(),
+                                                               account->account_send_trans_number(), account->account_send_trans_hash(),
+                                                               action, action_params, timestamp, EXPIRE_DURATION);
+    return true;
+}
+
+void xrole_context_t::submit_self_txs(std::vector<xself_tx_t> const & batch, xblock_monitor_info_t * info, uint64_t timestamp) {
+    if (batch.empty()) {
         return;
     }
-    xtransaction_ptr_t tx = xtx_factory::create_sys_contract_call_self_tx(address.value(),
-                                                     account->account_send_trans_number(), account->account_send_trans_hash(),
-                                                     info->action, action_params, timestamp, EXPIRE_DURATION);
-
-    if (info->call_way == enum_call_action_way_t::consensus) {
-        int32_t r = m_unit_service->request_transaction_consensus(tx, true);
-        xinfo("[xrole_context_t] call_contract in consensus mode with return code : %d, %s, %s %s %ld, %lld",
-              r,
-              tx->get_digest_hex_str().c_str(),
-              address.c_str(),
-              data::to_hex_str(account->account_send_trans_hash()).c_str(),
-              account->account_send_trans_number(),
-              timestamp);
-    } else {
-        // TODO(jimmy) now support
-        xassert(false);
-        // xvm::xvm_service s;
-        // xaccount_context_t ac(address.value(), m_store.get());
-        // auto trace = s.deal_transaction(tx, &ac);
-        // xinfo("[xrole_context_t] call_contract in no_consensus mode with return code : %d", (int)trace->m_errno);
+
+    auto const begin = std::chrono::steady_clock::now();
+    for (auto const & self_tx : batch) {
+        if (info->call_way == enum_call_action_way_t::consensus) {
+            int32_t r = m_unit_service->request_transaction_consensus(self_tx.tx, true);
+            xinfo("[xrole_context_t] call_contract in consensus mode with return code : %d, %s, %s %s %ld, %lld",
+                  r,
+                  self_tx.tx->get_digest_hex_str().c_str(),
+                  self_tx.address.value().c_str(),
+                  data::to_hex_str(self_tx.account->account_send_trans_hash()).c_str(),
+                  self_tx.account->account_send_trans_number(),
+                  timestamp);
+        } else {
+            // TODO(jimmy) now support
+            xassert(false);
+            // xvm::xvm_service s;
+            // xaccount_context_t ac(address.value(), m_store.get());
+            // auto trace = s.deal_transaction(tx, &ac);
+            // xinfo("[xrole_context_t] call_contract in no_consensus mode with return code : %d", (int)trace->m_errno);
+        }
     }
+    XMETRICS_COUNTER_SET("xvm_self_tx_batch_size", batch.size());
+    XMETRICS_COUNTER_SET("xvm_self_tx_submit_time_us", std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count());
 }
 
 void xrole_context_t::on_fulltableblock_event(common::xaccount_address_t const& contract_name, std::string const& action_name, std::string const& action_params, uint64_t timestamp, uint16_t table_id) {
     auto const address = xcontract_address_map_t::calc_cluster_address(contract_name, table_id);
-    xaccount_ptr_t account = m_store->query_account(address.value());
+    xaccount_ptr_t account = m_account_state_cache.account(address, m_store, m_syncstore->get_vblockstore());
     if (nullptr == account) {
         xerror("xrole_context_t::on_fulltableblock_event fail-query account.address=%s", address.c_str());
         xassert(nullptr != account);
@@ -429,9 +514,8 @@ void xrole_context_t::on_fulltableblock_event(common::xaccount_address_t const&
 
 void xrole_context_t::broadcast(const xblock_ptr_t & block_ptr, common::xnode_type_t types) {
     assert(block_ptr != nullptr);
-    base::xstream_t stream(base::xcontext_t::instance());
-    block_ptr->full_block_serialize_to(stream);
-    auto message = xmessage_t({stream.data(), stream.data() + stream.size()}, xmessage_block_broadcast_id);
+    auto const message_ptr = xbroadcast_message_cache_t::instance().get(block_ptr);
+    auto const & message = *message_ptr;
 
     if (common::has<common::xnode_type_t::real_part_mask>(types)) {
         common::xnode_address_t dest{common::xcluster_address_t{m_driver->network_id()}};
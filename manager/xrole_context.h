@@ -10,10 +10,17 @@
 #include "xdata/xfulltableblock_account_data.h"
 #include "xstore/xstore_face.h"
 #include "xtxpool_service_v2/xrequest_tx_receiver_face.h"
+#include "xvledger/xvblock.h"
 #include "xvledger/xvcnode.h"
+#include "xvm/manager/xaccount_state_cache.h"
 #include "xvm/xcontract_info.h"
 #include "xvnetwork/xvnetwork_driver_face.h"
 
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
 NS_BEG2(top, contract)
 
 using namespace top::mbus;
@@ -31,6 +38,8 @@ struct xtable_schedule_info_t {
     xtable_schedule_info_t(uint16_t clock_interval, uint16_t start_table): target_interval{clock_interval}, cur_table{start_table}{}
 };
 
+constexpr uint64_t xtimer_never_due{std::numeric_limits<uint64_t>::max()};
+
 class xrole_context_t {
 public:
     xrole_context_t(const observer_ptr<xstore_face_t> & store,
@@ -47,6 +56,46 @@ public:
      */
     void on_block_to_db(const xblock_ptr_t & block, bool & event_broadcasted);
 
+    /**
+     * @brief drop the cached account states the committed table block may have changed
+     *
+     * @param block committed table block
+     */
+    void on_block_committed(const xblock_ptr_t & block);
+
+    /**
+     * @brief check if the block monitors of this context need the full table block
+     *
+     * @param block committed table block
+     * @return true
+     * @return false
+     */
+    bool needs_full_block(const xblock_ptr_t & block) const;
+
+    /**
+     * @brief load the full table block of the committed block
+     *
+     * @param block committed table block
+     * @return base::xauto_ptr<base::xvblock_t>
+     */
+    static base::xauto_ptr<base::xvblock_t> load_full_block(const xblock_ptr_t & block);
+
+    /**
+     * @brief process the block monitors of the store event, independent of other contexts
+     *
+     * @param block committed table block
+     * @param full_block the full table block shared by all contexts, nullptr to load it here
+     */
+    void on_block_monitors(const xblock_ptr_t & block, base::xvblock_t * full_block);
+
+    /**
+     * @brief process the broadcasts of the store event, only one context broadcasts a block
+     *
+     * @param block committed table block
+     * @param event_broadcasted set once a context broadcasts the block
+     */
+    void on_block_broadcasts(const xblock_ptr_t & block, bool & event_broadcasted);
+
     /**
      * @brief process chain timer event
      *
@@ -54,6 +103,22 @@ public:
      */
     void on_block_timer(const xevent_ptr_t & e);
 
+    /**
+     * @brief the timer monitor handling beacon timer blocks
+     *
+     * @return xtimer_block_monitor_info_t*  nullptr if the contract does not run on the beacon timer
+     */
+    xtimer_block_monitor_info_t * beacon_timer_monitor() const;
+
+    /**
+     * @brief the first timer round >= round at which on_block_timer may call the contract.
+     *        rounds before it are known to be no-ops, so the scheduler does not need to wake the context.
+     *
+     * @param round timer round
+     * @return uint64_t  the round, xtimer_never_due if a beacon timer block never calls the contract
+     */
+    uint64_t next_timer_round(const uint64_t round) const;
+
     /**
      * @brief check if this timer round is valid
      *
@@ -119,6 +184,42 @@ protected:
      * @return false
      */
     bool is_timer_unorder(common::xaccount_address_t const & address, uint64_t timestamp);
+    /**
+     * @brief self transaction of a contract account, built and ready to submit
+     *
+     */
+    struct xself_tx_t {
+        common::xaccount_address_t address{};
+        xaccount_ptr_t account{};
+        xtransaction_ptr_t tx{};
+    };
+
+    /**
+     * @brief build the self transaction calling action on the contract account
+     *
+     * @param address contract account address
+     * @param action action name
+     * @param action_params serialized action params, shared by all txs of a tick
+     * @param timestamp timer timestamp
+     * @param self_tx built tx
+     * @return true built
+     * @return false account state not found
+     */
+    bool build_self_tx(common::xaccount_address_t const & address,
+                       std::string const & action,
+                       std::string const & action_params,
+                       uint64_t timestamp,
+                       xself_tx_t & self_tx);
+
+    /**
+     * @brief submit the self transactions of one tick to the unit service, in order
+     *
+     * @param batch txs to submit
+     * @param info monitor info, decides the call way
+     * @param timestamp timer timestamp
+     */
+    void submit_self_txs(std::vector<xself_tx_t> const & batch, xblock_monitor_info_t * info, uint64_t timestamp);
+
     /**
      * @brief broadcast the block
      *
@@ -159,6 +260,7 @@ protected:
     xcontract_info_t *                                                          m_contract_info{};
     std::unordered_map<common::xaccount_address_t, uint64_t>                    m_address_round_map;  // record address and timer round
     std::unordered_map<common::xaccount_address_t, xtable_schedule_info_t>      m_table_contract_schedule; // table schedule
+    mutable xaccount_state_cache_t                                              m_account_state_cache; // nonce, hash and height of the contract accounts
 };
 
 NS_END2
@@ -0,0 +1,92 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+NS_BEG2(top, contract)
+
+/**
+ * @brief a read mostly map published as immutable snapshots.
+ *        readers take one atomic load and probe the snapshot without any lock.
+ *        writers copy the current snapshot, modify the copy and publish it.
+ *        snapshots are only freed with the map itself, since a reader may still hold an older one;
+ *        the maps using this are written a handful of times at startup, so the versions stay few.
+ */
+template <typename KeyT, typename ValueT>
+class xtop_snapshot_map {
+public:
+    using map_type = std::unordered_map<KeyT, ValueT>;
+
+    xtop_snapshot_map() {
+        publish(std::unique_ptr<map_type>{new map_type{}});
+    }
+
+    xtop_snapshot_map(xtop_snapshot_map const &) = delete;
+    xtop_snapshot_map & operator=(xtop_snapshot_map const &) = delete;
+    xtop_snapshot_map(xtop_snapshot_map &&) = delete;
+    xtop_snapshot_map & operator=(xtop_snapshot_map &&) = delete;
+    ~xtop_snapshot_map() = default;
+
+    /**
+     * @brief find the value of key
+     *
+     * @param key  the key
+     * @return ValueT  the value, ValueT{} if not found
+     */
+    ValueT find(KeyT const & key) const {
+        auto const * current = m_current.load(std::memory_order_acquire);
+        auto const it = current->find(key);
+        return it != current->end() ? it->second : ValueT{};
+    }
+
+    /**
+     * @brief the current snapshot, stays valid for the lifetime of the map
+     *
+     * @return map_type const&
+     */
+    map_type const & snapshot() const noexcept {
+        return *m_current.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief modify a copy of the current snapshot and publish it as one version
+     *
+     * @param modifier  called with the copy, batch all changes of one operation into it
+     */
+    template <typename ModifierT>
+    void update(ModifierT && modifier) {
+        std::lock_guard<std::mutex> lock{m_write_mutex};
+        std::unique_ptr<map_type> next{new map_type{*m_current.load(std::memory_order_relaxed)}};
+        modifier(*next);
+        publish(std::move(next));
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock{m_write_mutex};
+        publish(std::unique_ptr<map_type>{new map_type{}});
+    }
+
+private:
+    void publish(std::unique_ptr<map_type> next) {
+        m_current.store(next.get(), std::memory_order_release);
+        m_versions.push_back(std::move(next));
+    }
+
+    std::atomic<map_type const *> m_current{nullptr};
+    std::mutex m_write_mutex;
+    std::vector<std::unique_ptr<map_type const>> m_versions;
+};
+
+template <typename KeyT, typename ValueT>
+using xsnapshot_map_t = xtop_snapshot_map<KeyT, ValueT>;
+
+NS_END2
@@ -0,0 +1,124 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvm/manager/xtimer_scheduler.h"
+
+#include "xconfig/xconfig_register.h"
+
+#include <algorithm>
+
+NS_BEG2(top, contract)
+
+static bool read_config_interval(std::string const & key, uint32_t & interval) {
+    return config::xconfig_register_t::get_instance().get(key, interval);
+}
+
+void xtop_timer_scheduler::rebuild(std::vector<xrole_context_t *> const & contexts, uint64_t round) {
+    m_entries.clear();
+    m_buckets.clear();
+    m_config_intervals.clear();
+    m_config_entries.clear();
+
+    m_entries.reserve(contexts.size());
+    for (auto * context : contexts) {
+        auto const index = m_entries.size();
+        m_entries.push_back(xentry_t{context, xtimer_never_due});
+
+        auto const * timer_info = context->beacon_timer_monitor();
+        if (timer_info != nullptr && timer_info->interval_from_config()) {
+            auto const & key = timer_info->interval_config_key();
+            m_config_entries[key].push_back(index);
+            uint32_t interval{0};
+            if (read_config_interval(key, interval)) {
+                m_config_intervals[key] = interval;
+            }
+        }
+        schedule(index, round);
+    }
+    m_valid = true;
+}
+
+void xtop_timer_scheduler::invalidate() noexcept {
+    m_valid = false;
+}
+
+bool xtop_timer_scheduler::valid() const noexcept {
+    return m_valid;
+}
+
+std::vector<xrole_context_t *> xtop_timer_scheduler::due(uint64_t round) {
+    refresh_config_intervals(round);
+
+    std::vector<std::size_t> woken;
+    while (!m_buckets.empty() && m_buckets.begin()->first <= round) {
+        auto const due_round = m_buckets.begin()->first;
+        auto const indexes = std::move(m_buckets.begin()->second);
+        m_buckets.erase(m_buckets.begin());
+
+        for (auto const index : indexes) {
+            if (due_round == round) {
+                woken.push_back(index);
+            } else {
+                // the due round was skipped by the timer, on_block_timer only looks at the current round
+                schedule(index, round);
+            }
+        }
+    }
+
+    std::sort(woken.begin(), woken.end());
+    std::vector<xrole_context_t *> contexts;
+    contexts.reserve(woken.size());
+    for (auto const index : woken) {
+        contexts.push_back(m_entries[index].context);
+        schedule(index, round + 1);
+    }
+    return contexts;
+}
+
+uint64_t xtop_timer_scheduler::next_due_round() const noexcept {
+    return m_buckets.empty() ? xtimer_never_due : m_buckets.begin()->first;
+}
+
+std::size_t xtop_timer_scheduler::size() const noexcept {
+    return m_entries.size();
+}
+
+void xtop_timer_scheduler::schedule(std::size_t index, uint64_t round) {
+    auto & entry = m_entries[index];
+    entry.due_round = entry.context->next_timer_round(round);
+    if (entry.due_round != xtimer_never_due) {
+        m_buckets[entry.due_round].push_back(index);
+    }
+}
+
+void xtop_timer_scheduler::refresh_config_intervals(uint64_t round) {
+    // intervals from the config register may be changed by governance at any time
+    for (auto const & pair : m_config_entries) {
+        auto const & key = pair.first;
+        uint32_t interval{0};
+        if (!read_config_interval(key, interval)) {
+            continue;
+        }
+        auto it = m_config_intervals.find(key);
+        if (it != m_config_intervals.end() && it->second == interval) {
+            continue;
+        }
+        m_config_intervals[key] = interval;
+
+        for (auto const index : pair.second) {
+            auto const old_due = m_entries[index].due_round;
+            auto bucket = m_buckets.find(old_due);
+            if (bucket != m_buckets.end()) {
+                auto & indexes = bucket->second;
+                indexes.erase(std::remove(indexes.begin(), indexes.end(), index), indexes.end());
+                if (indexes.empty()) {
+                    m_buckets.erase(bucket);
+                }
+            }
+            schedule(index, round);
+        }
+    }
+}
+
+NS_END2
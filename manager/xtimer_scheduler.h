@@ -0,0 +1,87 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+#include "xvm/manager/xrole_context.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+NS_BEG2(top, contract)
+
+/**
+ * @brief index of role contexts by the next timer round they may call their contract at.
+ *        a beacon timer block only wakes the contexts due at its round, all others are skipped.
+ */
+class xtop_timer_scheduler {
+public:
+    xtop_timer_scheduler() = default;
+    xtop_timer_scheduler(xtop_timer_scheduler const &) = delete;
+    xtop_timer_scheduler & operator=(xtop_timer_scheduler const &) = delete;
+    xtop_timer_scheduler(xtop_timer_scheduler &&) = default;
+    xtop_timer_scheduler & operator=(xtop_timer_scheduler &&) = default;
+    ~xtop_timer_scheduler() = default;
+
+    /**
+     * @brief rebuild the index from the role contexts
+     *
+     * @param contexts role contexts in the order they should be woken in
+     * @param round the first round to schedule from
+     */
+    void rebuild(std::vector<xrole_context_t *> const & contexts, uint64_t round);
+
+    /**
+     * @brief role contexts were added or removed, the index must be rebuilt before next use
+     *
+     */
+    void invalidate() noexcept;
+
+    bool valid() const noexcept;
+
+    /**
+     * @brief collect the role contexts due at round and schedule their next round.
+     *        rounds must be increasing, contexts due at a skipped round are rescheduled without being woken.
+     *
+     * @param round timer round
+     * @return std::vector<xrole_context_t *> due contexts, in rebuild order
+     */
+    std::vector<xrole_context_t *> due(uint64_t round);
+
+    /**
+     * @brief the first round a role context is due at
+     *
+     * @return uint64_t the round, xtimer_never_due if no context is scheduled
+     */
+    uint64_t next_due_round() const noexcept;
+
+    /**
+     * @brief number of indexed role contexts
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const noexcept;
+
+private:
+    struct xentry_t {
+        xrole_context_t * context{nullptr};
+        uint64_t due_round{xtimer_never_due};
+    };
+
+    void schedule(std::size_t index, uint64_t round);
+    void refresh_config_intervals(uint64_t round);
+
+    std::vector<xentry_t> m_entries;
+    std::map<uint64_t, std::vector<std::size_t>> m_buckets;  // due round => entry indexes
+    std::unordered_map<std::string, uint32_t> m_config_intervals;  // config key => interval used to schedule
+    std::unordered_map<std::string, std::vector<std::size_t>> m_config_entries;  // config key => entry indexes
+    bool m_valid{false};
+};
+using xtimer_scheduler_t = xtop_timer_scheduler;
+
+NS_END2
@@ -0,0 +1,90 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "gtest/gtest.h"
+#include "xbase/xcontext.h"
+#include "xbase/xmem.h"
+#include "xvm/xsystem_contracts/tools/xreward_replay_dataset.h"
+#include "xvm/xsystem_contracts/xregistration/xreg_node_decoder.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+
+using top::base::xcontext_t;
+using top::base::xstream_t;
+using namespace top::xstake;
+
+static std::string serialized(xreg_node_info const & node) {
+    xstream_t stream(xcontext_t::instance());
+    node.serialize_to(stream);
+    return std::string{reinterpret_cast<char const *>(stream.data()), static_cast<std::size_t>(stream.size())};
+}
+
+// the per record decode the callers did before xreg_node_decoder_t
+static std::map<top::common::xaccount_address_t, xreg_node_info> decode_per_record(std::map<std::string, std::string> const & reg_map) {
+    std::map<top::common::xaccount_address_t, xreg_node_info> nodes;
+    for (auto const & entity : reg_map) {
+        xreg_node_info node;
+        xstream_t stream(xcontext_t::instance(), (uint8_t *)entity.second.data(), static_cast<uint32_t>(entity.second.size()));
+        node.serialize_from(stream);
+        nodes[top::common::xaccount_address_t{entity.first}] = node;
+    }
+    return nodes;
+}
+
+static void expect_same(std::map<top::common::xaccount_address_t, xreg_node_info> const & expected, std::vector<xreg_node_record_t> const & records) {
+    ASSERT_EQ(expected.size(), records.size());
+    auto it = expected.begin();
+    for (auto const & record : records) {
+        EXPECT_TRUE(it->first == record.account) << record.account.to_string();
+        EXPECT_EQ(serialized(it->second), serialized(record.node)) << record.account.to_string();
+        ++it;
+    }
+}
+
+TEST(xreg_node_decoder, decode_matches_per_record_decode) {
+    auto const dataset = xreward_replay_dataset_t::make_synthetic(1000, 0, 7);
+    xreg_node_decoder_t decoder;
+    expect_same(decode_per_record(dataset.reg_nodes), decoder.decode(dataset.reg_nodes));
+
+    // a second round over a changed node set reuses the decoder
+    auto const changed = xreward_replay_dataset_t::make_synthetic(500, 0, 8);
+    expect_same(decode_per_record(changed.reg_nodes), decoder.decode(changed.reg_nodes));
+}
+
+TEST(xreg_node_decoder, append_decodes_shard_by_shard) {
+    auto const dataset = xreward_replay_dataset_t::make_synthetic(1000, 0, 9);
+    auto middle = dataset.reg_nodes.begin();
+    std::advance(middle, dataset.reg_nodes.size() / 2);
+    std::map<std::string, std::string> const first{dataset.reg_nodes.begin(), middle};
+    std::map<std::string, std::string> const second{middle, dataset.reg_nodes.end()};
+
+    xreg_node_decoder_t decoder;
+    decoder.decode(first);
+    expect_same(decode_per_record(dataset.reg_nodes), decoder.decode(second, true));
+}
+
+TEST(xreg_node_decoder, decode_10k_nodes) {
+    auto const dataset = xreward_replay_dataset_t::make_synthetic(10000, 0, 10);
+    std::size_t const rounds{10};
+
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < rounds; ++i) {
+        EXPECT_EQ(dataset.reg_nodes.size(), decode_per_record(dataset.reg_nodes).size());
+    }
+    auto const per_record_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+
+    xreg_node_decoder_t decoder;
+    begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < rounds; ++i) {
+        EXPECT_EQ(dataset.reg_nodes.size(), decoder.decode(dataset.reg_nodes).size());
+    }
+    auto const decoder_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+
+    std::printf("10000 nodes x %zu rounds: per record decode %lldus, xreg_node_decoder_t %lldus\n",
+                rounds,
+                static_cast<long long>(per_record_us),
+                static_cast<long long>(decoder_us));
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "gtest/gtest.h"
+#include "xbase/xcontext.h"
+#include "xbase/xmem.h"
+#include "xvm/xsystem_contracts/tools/xreward_replay_dataset.h"
+#include "xvm/xsystem_contracts/xreward/xreward_task_params.h"
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using top::base::xcontext_t;
+using top::base::xstream_t;
+using namespace top::xstake;
+
+using xstring_rewards_t = std::map<std::string, top::xstake::uint128_t>;
+
+static xreward_task_params_t::rewards_t make_rewards(std::size_t count, uint32_t seed) {
+    auto const dataset = xreward_replay_dataset_t::make_synthetic(count, 0, seed);
+    std::mt19937_64 random{seed};
+    xreward_task_params_t::rewards_t rewards;
+    for (auto const & entity : dataset.reg_nodes) {
+        rewards[top::common::xaccount_address_t{entity.first}] = static_cast<top::xstake::uint128_t>(random()) * REWARD_PRECISION + random() % REWARD_PRECISION;
+    }
+    return rewards;
+}
+
+// the params as dispatch_all_reward_v3 encoded them before xreward_task_params_t, through a string keyed map
+static std::vector<std::string> encode_through_map(uint64_t onchain_timer_round, xreward_task_params_t::rewards_t const & rewards, std::size_t max_accounts) {
+    std::vector<std::string> params;
+    xstring_rewards_t chunk;
+    auto const close = [&] {
+        xstream_t stream(xcontext_t::instance());
+        stream << onchain_timer_round;
+        stream << chunk;
+        params.emplace_back(reinterpret_cast<char const *>(stream.data()), static_cast<std::size_t>(stream.size()));
+        chunk.clear();
+    };
+    for (auto const & reward : rewards) {
+        chunk.emplace(reward.first.to_string(), reward.second);
+        if (chunk.size() >= max_accounts) {
+            close();
+        }
+    }
+    if (!chunk.empty()) {
+        close();
+    }
+    return params;
+}
+
+TEST(xreward_task_params, round_trip) {
+    auto const rewards = make_rewards(2500, 21);
+    std::vector<std::string> params;
+    xreward_task_params_t::encode(1234, rewards, 1000, params);
+    ASSERT_EQ(3u, params.size());
+
+    xstring_rewards_t decoded;
+    xstring_rewards_t visited;
+    for (auto const & param : params) {
+        xstream_t stream(xcontext_t::instance(), (uint8_t *)param.data(), static_cast<uint32_t>(param.size()));
+        uint64_t onchain_timer_round{0};
+        xstring_rewards_t chunk;
+        stream >> onchain_timer_round;
+        stream >> chunk;
+        EXPECT_EQ(1234u, onchain_timer_round);
+        EXPECT_EQ(0, stream.size());
+        EXPECT_LE(chunk.size(), 1000u);
+        decoded.insert(chunk.begin(), chunk.end());
+
+        EXPECT_EQ(1234u, xreward_task_params_t::visit(param, [&visited](std::string const & account, top::xstake::uint128_t const & reward) {
+            visited.emplace(account, reward);
+        }));
+    }
+
+    xstring_rewards_t expected;
+    for (auto const & reward : rewards) {
+        expected.emplace(reward.first.to_string(), reward.second);
+    }
+    EXPECT_TRUE(expected == decoded);
+    EXPECT_TRUE(expected == visited);
+}
+
+TEST(xreward_task_params, size_matches_map_encoding) {
+    for (std::size_t const max_accounts : {1u, 7u, 1000u, 5000u}) {
+        auto const rewards = make_rewards(2000, 22);
+        std::vector<std::string> params;
+        xreward_task_params_t::encode(42, rewards, max_accounts, params);
+        auto const expected = encode_through_map(42, rewards, max_accounts);
+
+        ASSERT_EQ(expected.size(), params.size()) << max_accounts;
+        for (std::size_t i = 0; i < params.size(); ++i) {
+            EXPECT_EQ(expected[i].size(), params[i].size()) << max_accounts << " " << i;
+            EXPECT_TRUE(expected[i] == params[i]) << max_accounts << " " << i;
+        }
+    }
+
+    std::vector<std::string> params;
+    xreward_task_params_t::encode(42, xreward_task_params_t::rewards_t{}, 1000, params);
+    EXPECT_TRUE(params.empty());
+}
@@ -0,0 +1,152 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// the per voter reference below calls the table helpers of the contract
+#define private public
+#include "xvm/xsystem_contracts/xreward/xzec_reward_contract.h"
+#include "xvm/xsystem_contracts/tools/xreward_replay_dataset.h"
+#undef private
+
+using namespace top::xstake;
+using top::common::xaccount_address_t;
+
+using xvotes_detail_t = std::map<xaccount_address_t, std::map<xaccount_address_t, uint64_t>>;
+using xtable_detail_t = std::map<xaccount_address_t, std::map<xaccount_address_t, top::xstake::uint128_t>>;
+
+// calc_votes as it was before xvote_index_t, looking every node up in the tickets of every voter
+static uint64_t calc_votes_per_voter(xvotes_detail_t const & votes_detail,
+                                     std::map<xaccount_address_t, xreg_node_info> & map_nodes,
+                                     std::map<xaccount_address_t, uint64_t> & account_votes) {
+    for (auto & entity : map_nodes) {
+        uint64_t node_total_votes = 0;
+        for (auto const & vote_detail : votes_detail) {
+            auto iter = vote_detail.second.find(entity.first);
+            if (iter != vote_detail.second.end()) {
+                account_votes[entity.first] += iter->second;
+                node_total_votes += iter->second;
+            }
+        }
+        entity.second.m_vote_amount = node_total_votes;
+    }
+    uint64_t total_votes = 0;
+    for (auto const & entity : votes_detail) {
+        for (auto const & entity2 : entity.second) {
+            auto it = map_nodes.find(entity2.first);
+            if (it == map_nodes.end()) {
+                continue;
+            }
+            if (it->second.deposit() > 0 && it->second.can_be_auditor()) {
+                total_votes += entity2.second;
+            }
+        }
+    }
+    return total_votes;
+}
+
+// calc_table_rewards as it was before xvote_index_t, visiting every voter for every rewarded node
+static void calc_table_rewards_per_voter(xzec_reward_contract & contract,
+                                         xreward_property_param_t & property_param,
+                                         std::map<xaccount_address_t, top::xstake::uint128_t> const & node_reward_detail,
+                                         std::map<xaccount_address_t, top::xstake::uint128_t> const & node_dividend_detail,
+                                         xtable_detail_t & table_node_reward_detail,
+                                         xtable_detail_t & table_node_dividend_detail,
+                                         std::map<xaccount_address_t, top::xstake::uint128_t> & table_total_rewards) {
+    std::map<xaccount_address_t, uint64_t> account_votes;
+    calc_votes_per_voter(property_param.votes_detail, property_param.map_nodes, account_votes);
+    for (auto const & reward : node_reward_detail) {
+        auto const table_address = contract.calc_table_contract_address(reward.first);
+        if (table_address.empty()) {
+            continue;
+        }
+        contract.calc_table_node_reward_detail(table_address, reward.first, reward.second, table_total_rewards, table_node_reward_detail);
+    }
+    for (auto const & reward : node_dividend_detail) {
+        for (auto const & vote_detail : property_param.votes_detail) {
+            auto const table_address = contract.calc_table_contract_address(vote_detail.first);
+            if (table_address.empty()) {
+                continue;
+            }
+            contract.calc_table_node_dividend_detail(
+                table_address, reward.first, reward.second, account_votes[reward.first], vote_detail.second, table_total_rewards, table_node_dividend_detail);
+        }
+    }
+}
+
+static xreward_property_param_t load_property_param(xreward_replay_dataset_t const & dataset) {
+    xreward_replay_context_t context{dataset};
+    top::common::xlogic_time_t activation_time{0};
+    xreward_onchain_param_t onchain_param;
+    xreward_property_param_t property_param;
+    xissue_detail issue_detail;
+    context.get_reward_param(activation_time, onchain_param, property_param, issue_detail);
+    return property_param;
+}
+
+TEST(xreward_votes, calc_votes_matches_per_voter_lookup) {
+    auto const dataset = xreward_replay_dataset_t::make_synthetic(2000, 5000, 11);
+    auto expected = load_property_param(dataset);
+    auto actual = load_property_param(dataset);
+    ASSERT_FALSE(expected.votes_detail.empty());
+
+    std::map<xaccount_address_t, uint64_t> expected_votes;
+    auto const expected_total = calc_votes_per_voter(expected.votes_detail, expected.map_nodes, expected_votes);
+
+    xzec_reward_contract contract{top::common::xnetwork_id_t{top::base::enum_main_chain_id}};
+    actual.vote_index.build(actual.votes_detail);
+    std::map<xaccount_address_t, uint64_t> actual_votes;
+    auto const actual_total = contract.calc_votes(actual.vote_index, actual.map_nodes, actual_votes);
+
+    EXPECT_EQ(expected_total, actual_total);
+    EXPECT_EQ(expected_votes, actual_votes);
+    EXPECT_EQ(expected_votes, contract.calc_votes(actual.votes_detail, actual.map_nodes));
+    ASSERT_EQ(expected.map_nodes.size(), actual.map_nodes.size());
+    for (auto const & entity : expected.map_nodes) {
+        EXPECT_EQ(entity.second.m_vote_amount, actual.map_nodes[entity.first].m_vote_amount) << entity.first.to_string();
+    }
+}
+
+TEST(xreward_votes, calc_table_rewards_matches_per_voter_lookup) {
+    auto const dataset = xreward_replay_dataset_t::make_synthetic(2000, 5000, 12);
+    auto expected = load_property_param(dataset);
+    auto actual = load_property_param(dataset);
+
+    // every node gets a self reward, every other one a dividend too
+    std::mt19937_64 random{12};
+    std::map<xaccount_address_t, top::xstake::uint128_t> node_reward_detail;
+    std::map<xaccount_address_t, top::xstake::uint128_t> node_dividend_detail;
+    std::size_t i = 0;
+    for (auto const & entity : expected.map_nodes) {
+        top::xstake::uint128_t const reward = random() % 1000000000000ULL;
+        node_reward_detail[entity.first] = reward * REWARD_PRECISION;
+        if (i++ % 2 == 0) {
+            node_dividend_detail[entity.first] = reward * REWARD_PRECISION / 3;
+        }
+    }
+
+    xzec_reward_contract contract{top::common::xnetwork_id_t{top::base::enum_main_chain_id}};
+    xtable_detail_t expected_node_rewards;
+    xtable_detail_t expected_dividends;
+    std::map<xaccount_address_t, top::xstake::uint128_t> expected_totals;
+    calc_table_rewards_per_voter(contract, expected, node_reward_detail, node_dividend_detail, expected_node_rewards, expected_dividends, expected_totals);
+
+    xtable_detail_t actual_node_rewards;
+    xtable_detail_t actual_dividends;
+    std::map<xaccount_address_t, top::xstake::uint128_t> actual_totals;
+    contract.calc_table_rewards(actual, node_reward_detail, node_dividend_detail, actual_node_rewards, actual_dividends, actual_totals);
+
+    ASSERT_FALSE(expected_dividends.empty());
+    EXPECT_TRUE(expected_node_rewards == actual_node_rewards);
+    EXPECT_TRUE(expected_dividends == actual_dividends);
+    EXPECT_TRUE(expected_totals == actual_totals);
+}
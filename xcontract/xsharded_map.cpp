@@ -0,0 +1,139 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvm/xcontract/xsharded_map.h"
+
+#include "xmetrics/xmetrics.h"
+#include "xutility/xhash.h"
+
+#include <cassert>
+
+NS_BEG3(top, xvm, xcontract)
+
+xtop_sharded_map::xtop_sharded_map(xcontract_base & contract, std::string base_key, uint32_t shard_count)
+  : m_contract{contract}, m_base_key{std::move(base_key)}, m_shard_count{shard_count} {
+    assert(m_shard_count > 0);
+}
+
+uint32_t xtop_sharded_map::shard_of(std::string const & field) const {
+    return (utl::xxh32_t::digest(field) % m_shard_count) + 1;
+}
+
+std::string xtop_sharded_map::shard_property(uint32_t shard_no) const {
+    assert(shard_no >= 1 && shard_no <= m_shard_count);
+    return m_base_key + "-" + std::to_string(shard_no);
+}
+
+uint32_t xtop_sharded_map::shard_count() const noexcept {
+    return m_shard_count;
+}
+
+void xtop_sharded_map::create() {
+    for (uint32_t i = 1; i <= m_shard_count; ++i) {
+        m_contract.MAP_CREATE(shard_property(i));
+    }
+}
+
+int32_t xtop_sharded_map::get(std::string const & field, std::string & value, std::string const & addr) const {
+    auto const shard_no = shard_of(field);
+    if (addr.empty()) {
+        auto const it = m_dirty_shards.find(shard_no);
+        if (it != m_dirty_shards.end()) {
+            auto const & changes = it->second;
+            if (changes.removed.count(field)) {
+                return -1;
+            }
+            auto const set_it = changes.set.find(field);
+            if (set_it != changes.set.end()) {
+                value = set_it->second;
+                return 0;
+            }
+        }
+    }
+    return m_contract.MAP_GET2(shard_property(shard_no), field, value, addr);
+}
+
+bool xtop_sharded_map::exist(std::string const & field) const {
+    auto const shard_no = shard_of(field);
+    auto const it = m_dirty_shards.find(shard_no);
+    if (it != m_dirty_shards.end()) {
+        if (it->second.removed.count(field)) {
+            return false;
+        }
+        if (it->second.set.count(field)) {
+            return true;
+        }
+    }
+    return m_contract.MAP_FIELD_EXIST(shard_property(shard_no), field);
+}
+
+void xtop_sharded_map::set(std::string const & field, std::string value) {
+    auto & changes = m_dirty_shards[shard_of(field)];
+    changes.removed.erase(field);
+    changes.set[field] = std::move(value);
+}
+
+void xtop_sharded_map::remove(std::string const & field) {
+    auto & changes = m_dirty_shards[shard_of(field)];
+    changes.set.erase(field);
+    changes.removed.insert(field);
+}
+
+void xtop_sharded_map::load_shard(uint32_t shard_no, std::map<std::string, std::string> & shard, std::string const & addr) const {
+    m_contract.MAP_COPY_GET(shard_property(shard_no), shard, addr);
+    if (!addr.empty()) {
+        return;
+    }
+
+    auto const it = m_dirty_shards.find(shard_no);
+    if (it == m_dirty_shards.end()) {
+        return;
+    }
+    for (auto const & field : it->second.removed) {
+        shard.erase(field);
+    }
+    for (auto const & change : it->second.set) {
+        shard[change.first] = change.second;
+    }
+}
+
+void xtop_sharded_map::for_each(visitor_t const & visitor, std::string const & addr) const {
+    for (uint32_t i = 1; i <= m_shard_count; ++i) {
+        std::map<std::string, std::string> shard;
+        load_shard(i, shard, addr);
+        for (auto const & entity : shard) {
+            visitor(entity.first, entity.second);
+        }
+    }
+}
+
+std::size_t xtop_sharded_map::flush() {
+    std::size_t written{0};
+    for (auto & dirty : m_dirty_shards) {
+        auto const property = shard_property(dirty.first);
+        auto & changes = dirty.second;
+        if (changes.set.empty() && changes.removed.empty()) {
+            continue;
+        }
+
+        // removing a missing field throws, as the MAP_REMOVE calls this map replaces did
+        for (auto const & field : changes.removed) {
+            m_contract.MAP_REMOVE(property, field);
+        }
+        for (auto const & change : changes.set) {
+            m_contract.MAP_SET(property, change.first, change.second);
+        }
+        ++written;
+    }
+    xdbg("[xtop_sharded_map::flush] base key %s, dirty shards %zu of %u", m_base_key.c_str(), written, m_shard_count);
+    XMETRICS_COUNTER_INCREMENT("xvm_sharded_map_flushed_shards", written);
+    m_dirty_shards.clear();
+    return written;
+}
+
+std::size_t xtop_sharded_map::dirty_shard_count() const noexcept {
+    return m_dirty_shards.size();
+}
+
+NS_END3
@@ -0,0 +1,145 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+#include "xvm/xcontract/xcontract_base.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+
+NS_BEG3(top, xvm, xcontract)
+
+/**
+ * @brief a logical map property split across several physical map properties.
+ *        field F lives in property "<base_key>-<n>", n = xxh32(F) % shard_count + 1,
+ *        which is the layout already used by the votes and voter dividend properties.
+ *        writes are staged per shard and only dirty shards are touched on flush.
+ */
+class xtop_sharded_map {
+public:
+    using visitor_t = std::function<void(std::string const & field, std::string const & value)>;
+
+    xtop_sharded_map(xtop_sharded_map const &) = delete;
+    xtop_sharded_map & operator=(xtop_sharded_map const &) = delete;
+    xtop_sharded_map(xtop_sharded_map &&) = default;
+    xtop_sharded_map & operator=(xtop_sharded_map &&) = delete;
+    ~xtop_sharded_map() = default;
+
+    /**
+     * @brief Construct a sharded map bound to a contract
+     *
+     * @param contract  the contract owning (or reading) the properties
+     * @param base_key  the property key prefix
+     * @param shard_count  the number of physical map properties
+     */
+    xtop_sharded_map(xcontract_base & contract, std::string base_key, uint32_t shard_count);
+
+    /**
+     * @brief the shard number the field belongs to, in [1, shard_count]
+     *
+     * @param field  the map field
+     * @return uint32_t  the shard number
+     */
+    uint32_t shard_of(std::string const & field) const;
+
+    /**
+     * @brief the physical property name of the shard
+     *
+     * @param shard_no  the shard number, in [1, shard_count]
+     * @return std::string  the property name
+     */
+    std::string shard_property(uint32_t shard_no) const;
+
+    uint32_t shard_count() const noexcept;
+
+    /**
+     * @brief create all physical map properties, used in contract setup
+     *
+     */
+    void create();
+
+    /**
+     * @brief get the field value, staged writes are visible
+     *
+     * @param field  the map field
+     * @param value  the value to store to
+     * @param addr  the addr the property belongs to, empty means self
+     * @return int32_t  0 on success
+     */
+    int32_t get(std::string const & field, std::string & value, std::string const & addr = "") const;
+
+    /**
+     * @brief check whether the field exists in the self properties, staged writes are visible
+     *
+     * @param field  the map field
+     * @return true  the field exists
+     * @return false  the field does not exist
+     */
+    bool exist(std::string const & field) const;
+
+    /**
+     * @brief stage a field write, applied by flush
+     *
+     * @param field  the map field
+     * @param value  the value
+     */
+    void set(std::string const & field, std::string value);
+
+    /**
+     * @brief stage a field removal, applied by flush. flush throws if the field does not exist
+     *
+     * @param field  the map field
+     */
+    void remove(std::string const & field);
+
+    /**
+     * @brief load one whole shard
+     *
+     * @param shard_no  the shard number, in [1, shard_count]
+     * @param shard  the shard content to store to, staged writes are merged in
+     * @param addr  the addr the property belongs to, empty means self
+     */
+    void load_shard(uint32_t shard_no, std::map<std::string, std::string> & shard, std::string const & addr = "") const;
+
+    /**
+     * @brief iterate all fields shard by shard, only one shard is held in memory at a time
+     *
+     * @param visitor  called for every field
+     * @param addr  the addr the property belongs to, empty means self
+     */
+    void for_each(visitor_t const & visitor, std::string const & addr = "") const;
+
+    /**
+     * @brief write staged changes of dirty shards back to the properties
+     *
+     * @return std::size_t  number of dirty shards written
+     */
+    std::size_t flush();
+
+    /**
+     * @brief number of shards with staged changes
+     *
+     * @return std::size_t
+     */
+    std::size_t dirty_shard_count() const noexcept;
+
+private:
+    struct xshard_changes_t {
+        std::map<std::string, std::string> set;
+        std::set<std::string> removed;
+    };
+
+    xcontract_base & m_contract;
+    std::string m_base_key;
+    uint32_t m_shard_count;
+    std::map<uint32_t, xshard_changes_t> m_dirty_shards;
+};
+using xsharded_map_t = xtop_sharded_map;
+
+NS_END3
@@ -0,0 +1,117 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvm/xcontract/xstream_pool.h"
+
+#include "xbase/xcontext.h"
+#include "xmetrics/xmetrics.h"
+
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <vector>
+
+NS_BEG3(top, xvm, xcontract)
+
+namespace {
+
+struct xthread_stream_pool_t {
+    std::vector<std::unique_ptr<base::xstream_t>> idle;
+    std::size_t peak_capacity{0};
+};
+
+xthread_stream_pool_t & thread_stream_pool() {
+    static thread_local xthread_stream_pool_t pool;
+    return pool;
+}
+
+// largest stream capacity returned to any pool, the peak gauge only ever moves up
+std::atomic<std::size_t> peak_capacity{0};
+std::mutex peak_capacity_mutex;
+
+void update_peak_capacity(std::size_t const capacity) {
+    if (capacity <= peak_capacity.load(std::memory_order_relaxed)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock{peak_capacity_mutex};
+    if (capacity > peak_capacity.load(std::memory_order_relaxed)) {
+        peak_capacity.store(capacity, std::memory_order_relaxed);
+        XMETRICS_COUNTER_SET("xvm_stream_pool_peak_capacity", capacity);
+    }
+}
+
+}  // namespace
+
+xtop_pooled_stream::xtop_pooled_stream() : m_stream{xstream_pool_t::take()} {
+}
+
+xtop_pooled_stream::~xtop_pooled_stream() {
+    if (m_stream != nullptr) {
+        xstream_pool_t::give_back(std::move(m_stream));
+    }
+}
+
+base::xstream_t & xtop_pooled_stream::stream() noexcept {
+    assert(m_stream != nullptr);
+    return *m_stream;
+}
+
+base::xstream_t & xtop_pooled_stream::operator*() noexcept {
+    return stream();
+}
+
+base::xstream_t * xtop_pooled_stream::operator->() noexcept {
+    return &stream();
+}
+
+std::string xtop_pooled_stream::to_string() const {
+    assert(m_stream != nullptr);
+    return {reinterpret_cast<char const *>(m_stream->data()), static_cast<std::size_t>(m_stream->size())};
+}
+
+void xtop_pooled_stream::assign_to(std::string & target) const {
+    assert(m_stream != nullptr);
+    target.assign(reinterpret_cast<char const *>(m_stream->data()), static_cast<std::size_t>(m_stream->size()));
+}
+
+xpooled_stream_t xtop_stream_pool::acquire() {
+    return xpooled_stream_t{};
+}
+
+std::size_t xtop_stream_pool::idle_count() {
+    return thread_stream_pool().idle.size();
+}
+
+std::unique_ptr<base::xstream_t> xtop_stream_pool::take() {
+    auto & pool = thread_stream_pool();
+    if (pool.idle.empty()) {
+        XMETRICS_COUNTER_INCREMENT("xvm_stream_pool_allocated", 1);
+        return std::unique_ptr<base::xstream_t>{new base::xstream_t{base::xcontext_t::instance()}};
+    }
+
+    XMETRICS_COUNTER_INCREMENT("xvm_stream_pool_reused", 1);
+    auto stream = std::move(pool.idle.back());
+    pool.idle.pop_back();
+    return stream;
+}
+
+void xtop_stream_pool::give_back(std::unique_ptr<base::xstream_t> stream) {
+    auto & pool = thread_stream_pool();
+    // a stream keeps its buffer after reset(), so retention is decided by capacity, not by what it holds now
+    auto const capacity = static_cast<std::size_t>(stream->capacity());
+    if (capacity > pool.peak_capacity) {
+        pool.peak_capacity = capacity;
+        update_peak_capacity(capacity);
+    }
+
+    if (capacity > max_retained_size || pool.idle.size() >= max_idle_streams) {
+        XMETRICS_COUNTER_INCREMENT("xvm_stream_pool_released", 1);
+        return;
+    }
+
+    stream->reset();
+    pool.idle.push_back(std::move(stream));
+}
+
+NS_END3
@@ -0,0 +1,98 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xmem.h"
+#include "xbase/xns_macro.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+NS_BEG3(top, xvm, xcontract)
+
+/**
+ * @brief a stream borrowed from the thread local stream pool.
+ *        the stream is empty when acquired and goes back to the pool on destruction,
+ *        so its buffer is reused by the next serialization on the same thread.
+ */
+class xtop_pooled_stream {
+public:
+    xtop_pooled_stream();
+    xtop_pooled_stream(xtop_pooled_stream const &) = delete;
+    xtop_pooled_stream & operator=(xtop_pooled_stream const &) = delete;
+    xtop_pooled_stream(xtop_pooled_stream &&) = default;
+    xtop_pooled_stream & operator=(xtop_pooled_stream &&) = delete;
+    ~xtop_pooled_stream();
+
+    base::xstream_t & stream() noexcept;
+    base::xstream_t & operator*() noexcept;
+    base::xstream_t * operator->() noexcept;
+
+    /**
+     * @brief the serialized bytes, used as property value or call parameter
+     *
+     * @return std::string  the bytes
+     */
+    std::string to_string() const;
+
+    /**
+     * @brief write the serialized bytes into target, reusing the capacity target already holds
+     *
+     * @param target  the string to store to
+     */
+    void assign_to(std::string & target) const;
+
+private:
+    std::unique_ptr<base::xstream_t> m_stream;
+};
+using xpooled_stream_t = xtop_pooled_stream;
+
+/**
+ * @brief per thread pool of reusable serialization streams
+ */
+class xtop_stream_pool {
+public:
+    /// at most this many idle streams are kept per thread
+    static constexpr std::size_t max_idle_streams{8};
+    /// streams whose buffer capacity grew larger than this are released instead of pooled
+    static constexpr std::size_t max_retained_size{4 * 1024 * 1024};
+
+    /**
+     * @brief borrow an empty stream from the calling thread's pool
+     *
+     * @return xpooled_stream_t  the borrowed stream
+     */
+    static xpooled_stream_t acquire();
+
+    /**
+     * @brief serialize object with a pooled stream
+     *
+     * @param object  the object serialized by operator<<
+     * @return std::string  the bytes
+     */
+    template <typename T>
+    static std::string serialize(T const & object) {
+        auto pooled = acquire();
+        *pooled << object;
+        return pooled.to_string();
+    }
+
+    /**
+     * @brief number of idle streams of the calling thread
+     *
+     * @return std::size_t
+     */
+    static std::size_t idle_count();
+
+private:
+    friend class xtop_pooled_stream;
+
+    static std::unique_ptr<base::xstream_t> take();
+    static void give_back(std::unique_ptr<base::xstream_t> stream);
+};
+using xstream_pool_t = xtop_stream_pool;
+
+NS_END3
@@ -75,6 +75,15 @@ public:
         return 0;
     }
 
+    /// true if the interval is read from the config register on every get_interval
+    bool interval_from_config() const noexcept {
+        return timer_interval == 0 && !conf_interval.empty();
+    }
+
+    std::string const & interval_config_key() const noexcept {
+        return conf_interval;
+    }
+
     virtual ~xtimer_block_monitor_info_t() {}
 
     xblock_monitor_info_t* clone() override {
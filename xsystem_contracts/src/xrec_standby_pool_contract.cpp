@@ -17,6 +17,7 @@
 #include "xdata/xrootblock.h"
 #include "xstake/xstake_algorithm.h"
 #include "xvm/xserialization/xserialization.h"
+#include "xvm/xsystem_contracts/xregistration/xreg_node_decoder.h"
 
 #ifdef STATIC_CONSENSUS
 #    include "xvm/xsystem_contracts/xelection/xstatic_election_center.h"
@@ -457,13 +458,9 @@ void xtop_rec_standby_pool_contract::on_timer(common::xlogic_time_t const curren
     xdbg("[xrec_standby_pool_contract_t][on_timer] registration data size %zu", reg_node_info.size());
 
     std::map<common::xnode_id_t, xstake::xreg_node_info> registration_data;
-    for (auto const & item : reg_node_info) {
-        xstake::xreg_node_info node_info;
-        base::xstream_t stream(base::xcontext_t::instance(), (uint8_t *)item.second.c_str(), (uint32_t)item.second.size());
-
-        node_info.serialize_from(stream);
-        registration_data[common::xnode_id_t{item.first}] = node_info;
-        xdbg("[xrec_standby_pool_contract_t][on_timer] found from registration contract node %s", item.first.c_str());
+    for (auto const & record : xstake::xreg_node_decoder_t::thread_instance().decode(reg_node_info)) {
+        registration_data.emplace_hint(registration_data.end(), record.account, record.node);
+        xdbg("[xrec_standby_pool_contract_t][on_timer] found from registration contract node %s", record.account.c_str());
     }
     XCONTRACT_ENSURE(!registration_data.empty(), "read registration data failed");
 
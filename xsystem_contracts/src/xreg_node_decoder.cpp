@@ -0,0 +1,46 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvm/xsystem_contracts/xregistration/xreg_node_decoder.h"
+
+#include "xbase/xcontext.h"
+#include "xbase/xmem.h"
+#include "xmetrics/xmetrics.h"
+
+NS_BEG2(top, xstake)
+
+std::vector<xreg_node_record_t> const & xtop_reg_node_decoder::decode(std::map<std::string, std::string> const & reg_map, bool append) {
+    XMETRICS_TIME_RECORD("xvm_reg_node_decoder_decode_time");
+    if (!append) {
+        m_records.clear();
+    }
+    m_records.reserve(m_records.size() + reg_map.size());
+
+    for (auto const & entity : reg_map) {
+        auto const & value_str = entity.second;
+        base::xstream_t stream(base::xcontext_t::instance(), (uint8_t *)value_str.data(), static_cast<uint32_t>(value_str.size()));
+
+        m_records.emplace_back();
+        auto & record = m_records.back();
+        record.account = common::xaccount_address_t{entity.first};
+        record.node.serialize_from(stream);
+    }
+    XMETRICS_COUNTER_INCREMENT("xvm_reg_node_decoder_decoded", reg_map.size());
+    return m_records;
+}
+
+std::vector<xreg_node_record_t> const & xtop_reg_node_decoder::records() const noexcept {
+    return m_records;
+}
+
+void xtop_reg_node_decoder::clear() {
+    m_records.clear();
+}
+
+xtop_reg_node_decoder & xtop_reg_node_decoder::thread_instance() {
+    static thread_local xtop_reg_node_decoder decoder;
+    return decoder;
+}
+
+NS_END2
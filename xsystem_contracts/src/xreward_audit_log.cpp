@@ -0,0 +1,233 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvm/xsystem_contracts/xreward/xreward_audit_log.h"
+
+#include "xbase/xlog.h"
+#include "xconfig/xconfig_register.h"
+#include "xmetrics/xmetrics.h"
+
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+
+NS_BEG2(top, xstake)
+
+constexpr std::size_t xtop_reward_audit_log::default_max_file_bytes;
+constexpr std::size_t xtop_reward_audit_log::default_max_files;
+constexpr std::size_t xtop_reward_audit_log::buffer_bytes;
+constexpr std::size_t xtop_reward_audit_log::max_pending_bytes;
+
+constexpr std::size_t xreward_audit_record_t::account_capacity;
+constexpr std::size_t xreward_audit_record_t::value_slots;
+constexpr std::size_t xreward_audit_record_t::header_size;
+constexpr std::size_t xreward_audit_record_t::value_size;
+constexpr std::size_t xreward_audit_record_t::max_encoded_size;
+constexpr uint32_t xreward_audit_record_t::version;
+constexpr std::size_t xreward_audit_record_t::file_header_size;
+
+static char const * const audit_log_path_config_key = "reward_audit_log_path";
+
+/**
+ * @brief executions are numbered from the process start time in the high 32 bits, so the numbers of a
+ *        restarted node don't repeat the ones already logged
+ */
+static uint64_t execution_base() {
+    static uint64_t const base = static_cast<uint64_t>(std::time(nullptr)) << 32;
+    return base;
+}
+
+xtop_reward_audit_log::~xtop_reward_audit_log() {
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        hand_off(true);
+        m_stop = true;
+    }
+    m_pending_cv.notify_one();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+    if (m_file != nullptr) {
+        std::fclose(m_file);
+    }
+}
+
+xtop_reward_audit_log & xtop_reward_audit_log::instance() {
+    // destroyed at exit, which hands the buffered records to the writer and joins it
+    static xtop_reward_audit_log inst;
+    return inst;
+}
+
+void xtop_reward_audit_log::open(std::string const & path, std::size_t max_file_bytes, std::size_t max_files) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    // records buffered so far still go to the old path, the writer switches files with the next chunk
+    hand_off(true);
+    m_configured = true;
+    m_path = path;
+    m_max_file_bytes = max_file_bytes;
+    m_max_files = max_files > 0 ? max_files : 1;
+}
+
+bool xtop_reward_audit_log::enabled() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    configure();
+    return !m_path.empty();
+}
+
+xreward_audit_execution_t xtop_reward_audit_log::begin_execution(uint64_t block_height) {
+    static std::atomic<uint32_t> executions{0};
+    return xreward_audit_execution_t{block_height, execution_base() | (executions.fetch_add(1) + 1)};
+}
+
+void xtop_reward_audit_log::append(xreward_audit_execution_t const & execution, xreward_audit_record_t const & record) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    configure();
+    if (m_path.empty()) {
+        return;
+    }
+
+    auto tagged = record;
+    tagged.block_height = execution.block_height;
+    tagged.execution = execution.execution;
+    auto const offset = m_buffer.size();
+    m_buffer.resize(offset + tagged.encoded_size());
+    tagged.encode(m_buffer.data() + offset);
+    ++m_buffer_records;
+    XMETRICS_COUNTER_INCREMENT("xvm_reward_audit_log_records", 1);
+    if (m_buffer.size() >= buffer_bytes) {
+        hand_off(false);
+    }
+}
+
+void xtop_reward_audit_log::flush() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    hand_off(true);
+}
+
+void xtop_reward_audit_log::configure() {
+    if (m_configured) {
+        return;
+    }
+    m_configured = true;
+    config::xconfig_register_t::get_instance().get(audit_log_path_config_key, m_path);
+    if (!m_path.empty()) {
+        xinfo("[xtop_reward_audit_log::configure] reward audit log at %s", m_path.c_str());
+    }
+}
+
+void xtop_reward_audit_log::hand_off(bool flush) {
+    if (m_buffer.empty()) {
+        return;
+    }
+    if (m_pending_bytes + m_buffer.size() > max_pending_bytes) {
+        // the writer fell behind, the contract execution is not made to wait for it
+        XMETRICS_COUNTER_INCREMENT("xvm_reward_audit_log_dropped", m_buffer_records);
+        m_buffer.clear();
+        m_buffer_records = 0;
+        return;
+    }
+
+    m_pending_bytes += m_buffer.size();
+    m_pending.push_back(xpending_chunk_t{m_path, m_max_file_bytes, m_max_files, m_buffer_records, flush, std::move(m_buffer)});
+    m_buffer = std::vector<uint8_t>{};
+    m_buffer_records = 0;
+    if (!m_writer.joinable()) {
+        m_writer = std::thread{&xtop_reward_audit_log::run_writer, this};
+    }
+    m_pending_cv.notify_one();
+}
+
+void xtop_reward_audit_log::run_writer() {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    for (;;) {
+        m_pending_cv.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+        if (m_pending.empty()) {
+            return;
+        }
+        auto const chunk = std::move(m_pending.front());
+        m_pending.pop_front();
+        m_pending_bytes -= chunk.bytes.size();
+
+        lock.unlock();
+        write_chunk(chunk);
+        lock.lock();
+    }
+}
+
+void xtop_reward_audit_log::write_chunk(xpending_chunk_t const & chunk) {
+    if (m_file != nullptr && m_file_path != chunk.path) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+    m_file_path = chunk.path;
+    m_file_max_bytes = chunk.max_file_bytes;
+    m_file_max_files = chunk.max_files;
+    if (m_file == nullptr && !open_file()) {
+        XMETRICS_COUNTER_INCREMENT("xvm_reward_audit_log_dropped", chunk.records);
+        return;
+    }
+
+    auto const written = std::fwrite(chunk.bytes.data(), 1, chunk.bytes.size(), m_file);
+    if (written != chunk.bytes.size()) {
+        xwarn("[xtop_reward_audit_log::write_chunk] %s: wrote %zu of %zu bytes", m_file_path.c_str(), written, chunk.bytes.size());
+    }
+    m_file_bytes += written;
+    XMETRICS_COUNTER_INCREMENT("xvm_reward_audit_log_bytes", written);
+    if (chunk.flush) {
+        std::fflush(m_file);
+    }
+
+    if (m_file_bytes >= m_file_max_bytes) {
+        rotate();
+    }
+}
+
+bool xtop_reward_audit_log::open_file() {
+    // a file written in another record layout is rotated out instead of appended to
+    std::FILE * existing = std::fopen(m_file_path.c_str(), "rb");
+    if (existing != nullptr) {
+        uint8_t header[xreward_audit_record_t::file_header_size];
+        auto const read = std::fread(header, 1, sizeof(header), existing);
+        std::fclose(existing);
+        if (read > 0 && (read != sizeof(header) || !xreward_audit_record_t::check_file_header(header))) {
+            rotate();
+        }
+    }
+
+    m_file = std::fopen(m_file_path.c_str(), "ab");
+    if (m_file == nullptr) {
+        xwarn("[xtop_reward_audit_log::open_file] cannot open %s", m_file_path.c_str());
+        return false;
+    }
+
+    std::fseek(m_file, 0, SEEK_END);
+    auto const size = std::ftell(m_file);
+    m_file_bytes = size > 0 ? static_cast<std::size_t>(size) : 0;
+    if (m_file_bytes == 0) {
+        uint8_t header[xreward_audit_record_t::file_header_size];
+        xreward_audit_record_t::encode_file_header(header);
+        m_file_bytes += std::fwrite(header, 1, sizeof(header), m_file);
+    }
+    return true;
+}
+
+void xtop_reward_audit_log::rotate() {
+    if (m_file != nullptr) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+    m_file_bytes = 0;
+
+    for (auto i = m_file_max_files - 1; i > 0; --i) {
+        auto const from = i == 1 ? m_file_path : m_file_path + "." + std::to_string(i - 1);
+        auto const to = m_file_path + "." + std::to_string(i);
+        std::rename(from.c_str(), to.c_str());
+    }
+    if (m_file_max_files == 1) {
+        std::remove(m_file_path.c_str());
+    }
+    XMETRICS_COUNTER_INCREMENT("xvm_reward_audit_log_rotated", 1);
+}
+
+NS_END2
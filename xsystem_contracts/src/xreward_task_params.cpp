@@ -0,0 +1,62 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvm/xsystem_contracts/xreward/xreward_task_params.h"
+
+#include "xbase/xcontext.h"
+#include "xbase/xmem.h"
+#include "xmetrics/xmetrics.h"
+#include "xvm/xcontract/xstream_pool.h"
+
+NS_BEG2(top, xstake)
+
+using xvm::xcontract::xstream_pool_t;
+
+void xtop_reward_task_params::encode(uint64_t onchain_timer_round,
+                                     rewards_t const & rewards,
+                                     std::size_t max_accounts,
+                                     std::vector<std::string> & params) {
+    auto entries = xstream_pool_t::acquire();
+    uint32_t count{0};
+    auto const close = [&] {
+        auto stream = xstream_pool_t::acquire();
+        *stream << onchain_timer_round;
+        *stream << count;
+        std::string param = stream.to_string();
+        param.append(reinterpret_cast<char const *>(entries->data()), static_cast<std::size_t>(entries->size()));
+        params.push_back(std::move(param));
+        entries->reset();
+        count = 0;
+    };
+
+    for (auto const & reward : rewards) {
+        *entries << reward.first.to_string();
+        *entries << reward.second;
+        if (++count >= max_accounts) {
+            close();
+        }
+    }
+    if (count > 0) {
+        close();
+    }
+}
+
+uint64_t xtop_reward_task_params::visit(std::string const & params, visitor_t const & visit) {
+    base::xstream_t stream(base::xcontext_t::instance(), (uint8_t *)params.data(), static_cast<uint32_t>(params.size()));
+    uint64_t onchain_timer_round{0};
+    stream >> onchain_timer_round;
+
+    uint32_t count{0};
+    stream >> count;
+    std::string account;
+    top::xstake::uint128_t reward;
+    for (uint32_t i = 0; i < count; ++i) {
+        stream >> account;
+        stream >> reward;
+        visit(account, reward);
+    }
+    return onchain_timer_round;
+}
+
+NS_END2
@@ -8,6 +8,7 @@
 #include "xdata/xdatautil.h"
 #include "xdata/xnative_contract_address.h"
 #include "xmetrics/xmetrics.h"
+#include "xvm/xcontract/xsharded_map.h"
 
 NS_BEG4(top, xvm, system_contracts, reward)
 
@@ -86,16 +87,14 @@ xcontract::xcontract_base * xtop_table_reward_claiming_contract::clone() {
 }
 
 void xtop_table_reward_claiming_contract::update_vote_reward_record(common::xaccount_address_t const & account, xstake::xreward_record const & record) {
-    uint32_t sub_map_no = (utl::xxh32_t::digest(account.to_string()) % xstake::XPROPERTY_SPLITED_NUM) + 1;
-    std::string property{xstake::XPORPERTY_CONTRACT_VOTER_DIVIDEND_REWARD_KEY_BASE};
-    property += "-" + std::to_string(sub_map_no);
+    xcontract::xsharded_map_t voter_dividend{*this, xstake::XPORPERTY_CONTRACT_VOTER_DIVIDEND_REWARD_KEY_BASE, xstake::XPROPERTY_SPLITED_NUM};
 
     base::xstream_t stream(base::xcontext_t::instance());
     record.serialize_to(stream);
-    auto value_str = std::string((char *)stream.data(), stream.size());
+    voter_dividend.set(account.to_string(), std::string((char *)stream.data(), stream.size()));
     {
         XMETRICS_TIME_RECORD("sysContract_tableRewardClaiming_set_property_contract_voter_dividend_reward_key");
-        MAP_SET(property, account.to_string(), value_str);
+        voter_dividend.flush();
     }
 }
 
@@ -128,18 +127,17 @@ void xtop_table_reward_claiming_contract::recv_voter_dividend_reward(uint64_t is
         xdbg("[xtop_table_reward_claiming_contract::recv_voter_dividend_reward] MAP_COPY_GET XPORPERTY_CONTRACT_POLLABLE_KEY error:%s", e.what());
     }
 
-    for (auto i = 1; i <= xstake::XPROPERTY_SPLITED_NUM; ++i) {
-        std::string property_name{xstake::XPORPERTY_CONTRACT_VOTES_KEY_BASE};
-        property_name += "-" + std::to_string(i);
-
+    xcontract::xsharded_map_t const votes{*this, xstake::XPORPERTY_CONTRACT_VOTES_KEY_BASE, xstake::XPROPERTY_SPLITED_NUM};
+    auto const vote_table_addr = data::xdatautil::serialize_owner_str(sys_contract_sharding_vote_addr, table_id);
+    for (uint32_t i = 1; i <= votes.shard_count(); ++i) {
         std::map<std::string, std::string> voters;
 
         {
             XMETRICS_TIME_RECORD("sysContract_tableRewardClaiming_get_property_contract_votes_key");
-            MAP_COPY_GET(property_name, voters, data::xdatautil::serialize_owner_str(sys_contract_sharding_vote_addr, table_id));
+            votes.load_shard(i, voters, vote_table_addr);
         }
 
-        xdbg("[xtop_table_reward_claiming_contract::recv_voter_dividend_reward] vote maps %s size: %d, pid: %d", property_name.c_str(), voters.size(), getpid());
+        xdbg("[xtop_table_reward_claiming_contract::recv_voter_dividend_reward] vote maps %s size: %d, pid: %d", votes.shard_property(i).c_str(), voters.size(), getpid());
         //calc_voter_reward(voters);
         for (auto const & entity : voters) {
             auto const & account = entity.first;
@@ -388,19 +386,19 @@ int32_t xtop_table_reward_claiming_contract::get_working_reward_record(common::x
 }
 
 int32_t xtop_table_reward_claiming_contract::get_vote_reward_record(common::xaccount_address_t const & account, xstake::xreward_record & record) {
-    uint32_t sub_map_no = (utl::xxh32_t::digest(account.to_string()) % xstake::XPROPERTY_SPLITED_NUM) + 1;
-    std::string property;
-    property = property + xstake::XPORPERTY_CONTRACT_VOTER_DIVIDEND_REWARD_KEY_BASE + "-" + std::to_string(sub_map_no);
+    xcontract::xsharded_map_t const voter_dividend{*this, xstake::XPORPERTY_CONTRACT_VOTER_DIVIDEND_REWARD_KEY_BASE, xstake::XPROPERTY_SPLITED_NUM};
 
     std::string value_str;
 
     {
         XMETRICS_TIME_RECORD("sysContract_tableRewardClaiming_get_property_contract_voter_dividend_reward_key");
-        if (!MAP_FIELD_EXIST(property, account.to_string())) {
-            xdbg("[xtop_table_reward_claiming_contract::get_vote_reward_record] property: %s, account %s not exist", property.c_str(), account.c_str());
+        if (!voter_dividend.exist(account.to_string())) {
+            xdbg("[xtop_table_reward_claiming_contract::get_vote_reward_record] property: %s, account %s not exist",
+                 voter_dividend.shard_property(voter_dividend.shard_of(account.to_string())).c_str(),
+                 account.c_str());
             return -1;
         } else {
-            value_str = MAP_GET(property, account.to_string());
+            voter_dividend.get(account.to_string(), value_str);
         }
     }
 
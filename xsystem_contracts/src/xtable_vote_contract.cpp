@@ -11,6 +11,8 @@
 #include "xdata/xgenesis_data.h"
 #include "xmetrics/xmetrics.h"
 #include "xutility/xhash.h"
+#include "xvm/xcontract/xsharded_map.h"
+#include "xvm/xcontract/xstream_pool.h"
 
 using top::base::xcontext_t;
 using top::base::xstream_t;
@@ -69,10 +71,7 @@ void xtable_vote_contract::setup() {
                         adv_get_votes_detail[adv_get_votes.first] = adv_get_votes.second;
                     }
                 }
-                xstream_t stream(xcontext_t::instance());
-                stream << vote_detail.second;
-                std::string vote_info_str = std::string((char *)stream.data(), stream.size());
-                MAP_SET(property, vote_detail.first, vote_info_str);
+                MAP_SET(property, vote_detail.first, xstream_pool_t::serialize(vote_detail.second));
             }
         }
     }
@@ -163,14 +162,12 @@ int32_t xtable_vote_contract::get_node_info(const common::xaccount_address_t & a
 
 std::map<std::string, uint64_t> xtable_vote_contract::get_table_votes_detail(common::xaccount_address_t const & account){
     std::map<std::string, uint64_t> votes_table;
-    std::string vote_info_str;
-    uint32_t sub_map_no = (utl::xxh32_t::digest(account.to_string()) % xstake::XPROPERTY_SPLITED_NUM) + 1;
-    std::string property = std::string{XPORPERTY_CONTRACT_VOTES_KEY_BASE} + "-" + std::to_string(sub_map_no);
+    xsharded_map_t votes{*this, XPORPERTY_CONTRACT_VOTES_KEY_BASE, xstake::XPROPERTY_SPLITED_NUM};
     {
         XMETRICS_TIME_RECORD("sysContract_tableVote_get_property_contract_votes_key");
         std::string vote_info_str;
         // here if not success, means account has no vote info yet, so vote_info_str is empty, using above default votes_table directly
-        if (MAP_GET2(property, account.to_string(), vote_info_str)){
+        if (votes.get(account.to_string(), vote_info_str)){
             xwarn("[xtable_vote_contract::handle_votes] get property empty, account %s", account.c_str());
         }
         if (!vote_info_str.empty()) {
@@ -238,17 +235,15 @@ void xtable_vote_contract::calc_advance_tickets(common::xaccount_address_t const
 }
 
 void xtable_vote_contract::update_table_votes_detail(common::xaccount_address_t const & account, std::map<std::string, uint64_t> const & votes_table){
-    std::string property = std::string{XPORPERTY_CONTRACT_VOTES_KEY_BASE} + "-" + std::to_string((utl::xxh32_t::digest(account.to_string()) % xstake::XPROPERTY_SPLITED_NUM) + 1);
+    xsharded_map_t votes{*this, XPORPERTY_CONTRACT_VOTES_KEY_BASE, xstake::XPROPERTY_SPLITED_NUM};
     if (votes_table.size() == 0) {
-        MAP_REMOVE(property, account.to_string());
+        votes.remove(account.to_string());
     } else {
-        xstream_t stream(xcontext_t::instance());
-        stream << votes_table;
-        std::string vote_info_str = std::string((char *)stream.data(), stream.size());
-        {
-            XMETRICS_TIME_RECORD("sysContract_tableVote_set_property_contract_voter_key");
-            MAP_SET(property, account.to_string(), vote_info_str);
-        }
+        votes.set(account.to_string(), xstream_pool_t::serialize(votes_table));
+    }
+    {
+        XMETRICS_TIME_RECORD("sysContract_tableVote_set_property_contract_voter_key");
+        votes.flush();
     }
 }
 
@@ -0,0 +1,49 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvm/xsystem_contracts/xreward/xvote_index.h"
+
+NS_BEG2(top, xstake)
+
+void xtop_vote_index::build(std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, uint64_t>> const & votes_detail) {
+    m_voters.clear();
+    m_nodes.clear();
+    m_voters.reserve(votes_detail.size());
+
+    for (auto const & vote_detail : votes_detail) {
+        auto const voter = m_voters.size();
+        m_voters.push_back(vote_detail.first);
+        for (auto const & node_tickets : vote_detail.second) {
+            auto & entry = m_nodes[node_tickets.first];
+            entry.total += node_tickets.second;
+            entry.voters.push_back(xnode_voter_tickets_t{voter, node_tickets.second});
+        }
+    }
+    m_built = true;
+}
+
+bool xtop_vote_index::built() const noexcept {
+    return m_built;
+}
+
+bool xtop_vote_index::voted(common::xaccount_address_t const & node) const {
+    return m_nodes.find(node) != m_nodes.end();
+}
+
+uint64_t xtop_vote_index::node_total(common::xaccount_address_t const & node) const {
+    auto const it = m_nodes.find(node);
+    return it != m_nodes.end() ? it->second.total : 0;
+}
+
+std::vector<xnode_voter_tickets_t> const & xtop_vote_index::node_voters(common::xaccount_address_t const & node) const {
+    static std::vector<xnode_voter_tickets_t> const empty;
+    auto const it = m_nodes.find(node);
+    return it != m_nodes.end() ? it->second.voters : empty;
+}
+
+std::vector<common::xaccount_address_t> const & xtop_vote_index::voters() const noexcept {
+    return m_voters;
+}
+
+NS_END2
@@ -11,8 +11,15 @@
 #include "xdata/xgenesis_data.h"
 #include "xstake/xstake_algorithm.h"
 #include "xstore/xstore_error.h"
+#include "xvm/xcontract/xstream_pool.h"
+#include "xvm/xsystem_contracts/xreward/xreward_task_params.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
+#include <iterator>
+
+#include <sys/resource.h>
 
 using top::base::xcontext_t;
 using top::base::xstream_t;
@@ -38,6 +45,21 @@ enum { edger_idx = 0, archiver_idx, auditor_idx, validator_idx, role_type_idx_nu
 
 NS_BEG2(top, xstake)
 
+constexpr std::size_t xzec_reward_contract::task_num_per_round;
+constexpr std::size_t xzec_reward_contract::task_max_accounts;
+
+static xreward_audit_value_t audit_value(top::xstake::uint128_t const & value) {
+    return xreward_audit_value_t{static_cast<uint64_t>(value / REWARD_PRECISION), static_cast<uint32_t>(value % REWARD_PRECISION)};
+}
+
+static xreward_audit_record_t audit_record(xreward_audit_record_type_t const type, uint64_t const round, std::string account = std::string{}) {
+    xreward_audit_record_t record;
+    record.type = type;
+    record.round = round;
+    record.account = std::move(account);
+    return record;
+}
+
 xzec_reward_contract::xzec_reward_contract(common::xnetwork_id_t const & network_id) : xbase_t{network_id} {}
 
 void xzec_reward_contract::setup() {
@@ -98,7 +120,12 @@ void xzec_reward_contract::on_timer(const common::xlogic_time_t onchain_timer_ro
         return;
     }
 
-    if (MAP_SIZE(XPORPERTY_CONTRACT_TASK_KEY) > 0) {
+    // records of this execution are tagged with the block it makes, a re-executed block logs them again
+    if (xreward_audit_log_t::instance().enabled()) {
+        m_audit_execution = xreward_audit_log_t::begin_execution(get_blockchain_height(sys_contract_zec_reward_addr) + 1);
+    }
+
+    if (task_count() > 0) {
         execute_task();
     } else {
         if (reward_is_expire_v2(onchain_timer_round)) {
@@ -183,27 +210,64 @@ void xzec_reward_contract::reward(const common::xlogic_time_t current_time, std:
     XMETRICS_TIME_RECORD(XREWARD_CONTRACT "reward_ExecutionTime");
     XMETRICS_CPU_TIME_RECORD(XREWARD_CONTRACT "reward_cpu_time");
     xdbg("[xzec_reward_contract::reward] pid:%d\n", getpid());
+    auto const begin = std::chrono::steady_clock::now();
     // step1 get related params
     common::xlogic_time_t activation_time;  // system activation time
     xreward_onchain_param_t onchain_param;  // onchain params
     xreward_property_param_t property_param;    // property from self and other contracts
     xissue_detail issue_detail;     // issue details this round
     get_reward_param(current_time, activation_time, onchain_param, property_param, issue_detail);
-    XCONTRACT_ENSURE(current_time > activation_time, "current_time <= activation_time");
-    // step2 calculate node and table rewards
-    std::map<common::xaccount_address_t, top::xstake::uint128_t> node_reward_detail;   // <node, self reward>
-    std::map<common::xaccount_address_t, top::xstake::uint128_t> node_dividend_detail; // <node, dividend reward>
-    top::xstake::uint128_t community_reward;    // community reward
-    calc_nodes_rewards_v5(current_time, current_time - activation_time, onchain_param, property_param, issue_detail, node_reward_detail, node_dividend_detail, community_reward);
-    std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, top::xstake::uint128_t>> table_nodes_rewards;   // <table, <node, reward>>
-    std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, top::xstake::uint128_t>> table_vote_rewards;    // <table, <node be voted, reward>>
-    std::map<common::xaccount_address_t, top::xstake::uint128_t> contract_rewards; // <table, total reward>
-    calc_table_rewards(property_param, node_reward_detail, node_dividend_detail, table_nodes_rewards, table_vote_rewards, contract_rewards);
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "reward_round_param_load_time_us", std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count());
+    // step2 calculate node and table rewards, and the tasks dispatching them
+    xreward_round_result_t result;
+    calc_reward_round(current_time, activation_time, onchain_param, property_param, issue_detail, result);
     // step3 dispatch rewards
-    uint64_t actual_issuance;
-    dispatch_all_reward_v3(current_time, contract_rewards, table_nodes_rewards, table_vote_rewards, community_reward, actual_issuance);
+    {
+        XMETRICS_TIME_RECORD(XREWARD_CONTRACT "XPORPERTY_CONTRACT_TASK_KEY_SetExecutionTime");
+        add_tasks(result.tasks);
+    }
+    print_tasks();
     // step4 update property
-    update_property(current_time, actual_issuance, property_param.accumulated_reward_record, issue_detail);
+    update_property(current_time, result.actual_issuance, property_param.accumulated_reward_record, issue_detail);
+    xreward_audit_log_t::instance().flush();
+}
+
+void xzec_reward_contract::calc_reward_round(common::xlogic_time_t const current_time,
+                                             common::xlogic_time_t const activation_time,
+                                             xreward_onchain_param_t const & onchain_param,
+                                             xreward_property_param_t & property_param,
+                                             xissue_detail & issue_detail,
+                                             xreward_round_result_t & result) {
+    XCONTRACT_ENSURE(current_time > activation_time, "current_time <= activation_time");
+    auto const begin = std::chrono::steady_clock::now();
+    calc_nodes_rewards_v5(current_time,
+                          current_time - activation_time,
+                          onchain_param,
+                          property_param,
+                          issue_detail,
+                          result.node_reward_detail,
+                          result.node_dividend_detail,
+                          result.community_reward,
+                          result.timing);
+    auto const node_rewards_end = std::chrono::steady_clock::now();
+    calc_table_rewards(property_param, result.node_reward_detail, result.node_dividend_detail, result.table_nodes_rewards, result.table_vote_rewards, result.contract_rewards);
+    auto const table_rewards_end = std::chrono::steady_clock::now();
+    dispatch_all_reward_v3(
+        current_time, result.contract_rewards, result.table_nodes_rewards, result.table_vote_rewards, result.community_reward, result.actual_issuance, result.tasks);
+    auto const dispatch_end = std::chrono::steady_clock::now();
+    result.timing.table_rewards_us = std::chrono::duration_cast<std::chrono::microseconds>(table_rewards_end - node_rewards_end).count();
+    result.timing.dispatch_us = std::chrono::duration_cast<std::chrono::microseconds>(dispatch_end - table_rewards_end).count();
+
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "reward_round_node_rewards_time_us", std::chrono::duration_cast<std::chrono::microseconds>(node_rewards_end - begin).count());
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "reward_round_table_rewards_time_us", result.timing.table_rewards_us);
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "reward_round_dispatch_time_us", result.timing.dispatch_us);
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "reward_round_nodes", property_param.map_nodes.size());
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "reward_round_voters", property_param.vote_index.voters().size());
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "reward_round_tasks", result.tasks.size());
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        XMETRICS_COUNTER_SET(XREWARD_CONTRACT "reward_round_peak_rss_kb", usage.ru_maxrss);
+    }
 }
 
 bool xzec_reward_contract::reward_is_expire_v2(const uint64_t onchain_timer_round) {
@@ -242,29 +306,53 @@ bool xzec_reward_contract::reward_is_expire_v2(const uint64_t onchain_timer_roun
     return true;
 }
 
-uint32_t xzec_reward_contract::get_task_id() {
+std::size_t xzec_reward_contract::task_count() {
+    return static_cast<std::size_t>(MAP_SIZE(XPORPERTY_CONTRACT_TASK_KEY));
+}
+
+std::map<std::string, std::string> xzec_reward_contract::peek_tasks(std::size_t const count) {
     std::map<std::string, std::string> dispatch_tasks;
+    {
+        XMETRICS_TIME_RECORD(XREWARD_CONTRACT "XPORPERTY_CONTRACT_TASK_KEY_CopyGetExecutionTime");
+        MAP_COPY_GET(XPORPERTY_CONTRACT_TASK_KEY, dispatch_tasks);
+    }
+    if (dispatch_tasks.size() > count) {
+        auto last = dispatch_tasks.begin();
+        std::advance(last, count);
+        dispatch_tasks.erase(last, dispatch_tasks.end());
+    }
+    return dispatch_tasks;
+}
+
+void xzec_reward_contract::remove_tasks(std::map<std::string, std::string> const & tasks, std::size_t const count) {
+    std::size_t removed{0};
+    for (auto it = tasks.begin(); it != tasks.end() && removed < count; ++it, ++removed) {
+        MAP_REMOVE(XPORPERTY_CONTRACT_TASK_KEY, it->first);
+    }
+}
 
+void xzec_reward_contract::add_tasks(std::vector<std::string> const & tasks) {
+    // ids continue after the last task in the map, and restart at 0 once it is empty
+    std::map<std::string, std::string> dispatch_tasks;
     {
         XMETRICS_TIME_RECORD(XREWARD_CONTRACT "XPORPERTY_CONTRACT_TASK_KEY_GetExecutionTime");
         MAP_COPY_GET(XPORPERTY_CONTRACT_TASK_KEY, dispatch_tasks);
     }
-
-    uint32_t task_id = 0;
-    if (dispatch_tasks.size() > 0) {
-        auto it = dispatch_tasks.end();
-        it--;
-        task_id = base::xstring_utl::touint32(it->first);
-        task_id++;
+    uint64_t task_id{0};
+    if (!dispatch_tasks.empty()) {
+        task_id = base::xstring_utl::touint64(dispatch_tasks.rbegin()->first) + 1;
+    }
+    for (auto const & task : tasks) {
+        std::stringstream ss;
+        ss << std::setw(10) << std::setfill('0') << task_id++;
+        MAP_SET(XPORPERTY_CONTRACT_TASK_KEY, ss.str(), task);
     }
-    return task_id;
 }
 
-void xzec_reward_contract::add_task(const uint32_t task_id,
-                                    const uint64_t onchain_timer_round,
-                                    const std::string & contract,
-                                    const std::string & action,
-                                    const std::string & params) {
+std::string xzec_reward_contract::make_task(const uint64_t onchain_timer_round,
+                                            const std::string & contract,
+                                            const std::string & action,
+                                            const std::string & params) {
     xreward_dispatch_task task;
 
     task.onchain_timer_round = onchain_timer_round;
@@ -272,40 +360,45 @@ void xzec_reward_contract::add_task(const uint32_t task_id,
     task.action = action;
     task.params = params;
 
-    base::xstream_t stream(base::xcontext_t::instance());
-    task.serialize_to(stream);
-    std::stringstream ss;
-    ss << std::setw(10) << std::setfill('0') << task_id;
-    auto key = ss.str();
-    {
-        XMETRICS_TIME_RECORD(XREWARD_CONTRACT "XPORPERTY_CONTRACT_TASK_KEY_SetExecutionTime");
-        MAP_SET(XPORPERTY_CONTRACT_TASK_KEY, key, std::string((char *)stream.data(), stream.size()));
-    }
+    auto stream = xstream_pool_t::acquire();
+    task.serialize_to(*stream);
+    return stream.to_string();
 }
 
 void xzec_reward_contract::execute_task() {
     XMETRICS_TIME_RECORD(XREWARD_CONTRACT "execute_task_ExecutionTime");
     XMETRICS_CPU_TIME_RECORD(XREWARD_CONTRACT "execute_task_cpu_time");
-    std::map<std::string, std::string> dispatch_tasks;
     xreward_dispatch_task task;
 
+    auto const backlog = task_count();
+    xdbg("[xzec_reward_contract::execute_task] map size: %zu\n", backlog);
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "currentTaskCnt", backlog);
+
+    std::map<std::string, std::string> dispatch_tasks;
     {
         XMETRICS_TIME_RECORD(XREWARD_CONTRACT "XPORPERTY_CONTRACT_TASK_KEY_CopyGetExecutionTime");
-        MAP_COPY_GET(XPORPERTY_CONTRACT_TASK_KEY, dispatch_tasks);
+        dispatch_tasks = peek_tasks(task_num_per_round);
     }
 
-    xdbg("[xzec_reward_contract::execute_task] map size: %d\n", dispatch_tasks.size());
-    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "currentTaskCnt", dispatch_tasks.size());
-
-    const int32_t task_num_per_round = 16;
-    for (auto i = 0; i < task_num_per_round; i++) {
-        auto it = dispatch_tasks.begin();
-        if (it == dispatch_tasks.end())
-            return;
-
+    auto & audit_log = xreward_audit_log_t::instance();
+    auto const audit = audit_log.enabled();
+    std::size_t executed_tasks{0};
+    std::size_t spent_output_txs{0};
+    std::size_t spent_param_bytes{0};
+    for (auto it = dispatch_tasks.begin(); it != dispatch_tasks.end(); ++it) {
         xstream_t stream(xcontext_t::instance(), (uint8_t *)it->second.c_str(), (uint32_t)it->second.size());
         task.serialize_from(stream);
 
+        std::map<std::string, uint64_t> issuances;
+        if (task.action == XTRANSFER_ACTION) {
+            base::xstream_t seo_stream(base::xcontext_t::instance(), (uint8_t *)task.params.c_str(), (uint32_t)task.params.size());
+            seo_stream >> issuances;
+        }
+
+        // cost of the task, reported per round
+        auto const output_txs = task.action == XTRANSFER_ACTION ? issuances.size() : std::size_t{1};
+        auto const param_bytes = task.params.size();
+
         XMETRICS_PACKET_INFO(XREWARD_CONTRACT "executeTask",
                              "id",
                              it->first,
@@ -318,61 +411,71 @@ void xzec_reward_contract::execute_task() {
                              "onChainParamTaskNumPerRound",
                              task_num_per_round);
 
-        // debug output
-        if (task.action == XREWARD_CLAIMING_ADD_NODE_REWARD || task.action == XREWARD_CLAIMING_ADD_VOTER_DIVIDEND_REWARD) {
-            xstream_t stream_params(xcontext_t::instance(), (uint8_t *)task.params.c_str(), (uint32_t)task.params.size());
-            uint64_t onchain_timer_round;
-            std::map<std::string, top::xstake::uint128_t> rewards;
-            stream_params >> onchain_timer_round;
-            stream_params >> rewards;
-            for (auto const & r : rewards) {
+        // debug output, the amounts of a task are in the audit log since dispatch, so only the task is recorded there
+        if (audit) {
+            auto record = audit_record(xreward_audit_record_type_t::task, task.onchain_timer_round, task.contract);
+            record.add(base::xstring_utl::touint64(it->first));
+            record.add(task.action == XTRANSFER_ACTION ? 0 : task.action == XREWARD_CLAIMING_ADD_NODE_REWARD ? 1 : task.action == XREWARD_CLAIMING_ADD_VOTER_DIVIDEND_REWARD ? 2 : 3);
+            record.add(output_txs);
+            record.add(param_bytes);
+            audit_log.append(m_audit_execution, record);
+        } else if (task.action == XREWARD_CLAIMING_ADD_NODE_REWARD || task.action == XREWARD_CLAIMING_ADD_VOTER_DIVIDEND_REWARD) {
+            xreward_task_params_t::visit(task.params, [&task](std::string const & account, top::xstake::uint128_t const & reward) {
                 xinfo("[xzec_reward_contract::execute_task] contract: %s, action: %s, account: %s, reward: [%llu, %u], onchain_timer_round: %llu\n",
                     task.contract.c_str(),
                     task.action.c_str(),
-                    r.first.c_str(),
-                    static_cast<uint64_t>(r.second / REWARD_PRECISION),
-                    static_cast<uint32_t>(r.second % REWARD_PRECISION),
+                    account.c_str(),
+                    static_cast<uint64_t>(reward / REWARD_PRECISION),
+                    static_cast<uint32_t>(reward % REWARD_PRECISION),
                     task.onchain_timer_round);
-            }
+            });
         } else if (task.action == XTRANSFER_ACTION) {
-            std::map<std::string, uint64_t> issuances;
-            base::xstream_t seo_stream(base::xcontext_t::instance(), (uint8_t *)task.params.c_str(), (uint32_t)task.params.size());
-            seo_stream >> issuances;
             for (auto const & issue : issuances) {
                 xinfo("[xzec_reward_contract::execute_task] action: %s, contract account: %s, issuance: %llu, onchain_timer_round: %llu\n",
                     task.action.c_str(),
                     issue.first.c_str(),
                     issue.second,
                     task.onchain_timer_round);
-                TRANSFER(issue.first, issue.second);
             }
         }
 
-        if (task.action != XTRANSFER_ACTION) {
+        if (task.action == XTRANSFER_ACTION) {
+            for (auto const & issue : issuances) {
+                TRANSFER(issue.first, issue.second);
+            }
+        } else {
             CALL(common::xaccount_address_t{task.contract}, task.action, task.params);
         }
 
-        {
-            XMETRICS_TIME_RECORD(XREWARD_CONTRACT "XPORPERTY_CONTRACT_TASK_KEY_RemoveExecutionTime");
-            MAP_REMOVE(XPORPERTY_CONTRACT_TASK_KEY, it->first);
-        }
+        ++executed_tasks;
+        spent_output_txs += output_txs;
+        spent_param_bytes += param_bytes;
+    }
 
-        dispatch_tasks.erase(it);
+    {
+        XMETRICS_TIME_RECORD(XREWARD_CONTRACT "XPORPERTY_CONTRACT_TASK_KEY_RemoveExecutionTime");
+        remove_tasks(dispatch_tasks, executed_tasks);
     }
+    audit_log.flush();
+
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "task_backlog", backlog - executed_tasks);
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "task_drained_per_round", executed_tasks);
+    XMETRICS_COUNTER_INCREMENT(XREWARD_CONTRACT "task_drained", executed_tasks);
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "task_round_output_txs", spent_output_txs);
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "task_round_param_bytes", spent_param_bytes);
 }
 
 void xzec_reward_contract::print_tasks() {
 #if defined(DEBUG)
-    std::map<std::string, std::string> dispatch_tasks;
-    MAP_COPY_GET(XPORPERTY_CONTRACT_TASK_KEY, dispatch_tasks);
+    auto const dispatch_tasks = peek_tasks(task_count());
 
     xreward_dispatch_task task;
     for (auto const & p : dispatch_tasks) {
         xstream_t stream(xcontext_t::instance(), (uint8_t *)p.second.c_str(), (uint32_t)p.second.size());
         task.serialize_from(stream);
 
-        xdbg("[xzec_reward_contract::print_tasks] task id: %s, onchain_timer_round: %llu, contract: %s, action: %s\n",
-             p.first.c_str(),
+        xdbg("[xzec_reward_contract::print_tasks] task id: %llu, onchain_timer_round: %llu, contract: %s, action: %s\n",
+             p.first,
              task.onchain_timer_round,
              task.contract.c_str(),
              task.action.c_str());
@@ -496,18 +599,30 @@ top::xstake::uint128_t xzec_reward_contract::calc_issuance_internal(uint64_t tot
         if (remaining_clocks > 0) {
             auto reserve_reward = get_reserve_reward(issued_until_last_year_end, minimum_issuance, issuance_rate);
             additional_issuance += reserve_reward * remaining_clocks / TIMER_BLOCK_HEIGHT_PER_YEAR;
-            xinfo(
-                "[xzec_reward_contract::calc_issuance] cross year, last_issuance_year: %u, reserve_reward: [%llu, %u], remaining_clocks: %llu, issued_clocks: %u, "
-                "additional_issuance: [%llu, %u], issued_until_last_year_end: [%llu, %u]",
-                last_issuance_year,
-                static_cast<uint64_t>(reserve_reward / REWARD_PRECISION),
-                static_cast<uint32_t>(reserve_reward % REWARD_PRECISION),
-                remaining_clocks,
-                issued_clocks,
-                static_cast<uint64_t>(additional_issuance / REWARD_PRECISION),
-                static_cast<uint32_t>(additional_issuance % REWARD_PRECISION),
-                static_cast<uint64_t>(issued_until_last_year_end / REWARD_PRECISION),
-                static_cast<uint32_t>(issued_until_last_year_end % REWARD_PRECISION));
+            auto & audit_log = xreward_audit_log_t::instance();
+            if (audit_log.enabled()) {
+                auto record = audit_record(xreward_audit_record_type_t::issuance_year, total_height);
+                record.add(last_issuance_year);
+                record.add(audit_value(reserve_reward));
+                record.add(remaining_clocks);
+                record.add(issued_clocks);
+                record.add(audit_value(additional_issuance));
+                record.add(audit_value(issued_until_last_year_end));
+                audit_log.append(m_audit_execution, record);
+            } else {
+                xinfo(
+                    "[xzec_reward_contract::calc_issuance] cross year, last_issuance_year: %u, reserve_reward: [%llu, %u], remaining_clocks: %llu, issued_clocks: %u, "
+                    "additional_issuance: [%llu, %u], issued_until_last_year_end: [%llu, %u]",
+                    last_issuance_year,
+                    static_cast<uint64_t>(reserve_reward / REWARD_PRECISION),
+                    static_cast<uint32_t>(reserve_reward % REWARD_PRECISION),
+                    remaining_clocks,
+                    issued_clocks,
+                    static_cast<uint64_t>(additional_issuance / REWARD_PRECISION),
+                    static_cast<uint32_t>(additional_issuance % REWARD_PRECISION),
+                    static_cast<uint64_t>(issued_until_last_year_end / REWARD_PRECISION),
+                    static_cast<uint32_t>(issued_until_last_year_end % REWARD_PRECISION));
+            }
             issued_clocks += remaining_clocks;
             last_issuance_time += remaining_clocks;
             issued_until_last_year_end += reserve_reward;
@@ -521,24 +636,39 @@ top::xstake::uint128_t xzec_reward_contract::calc_issuance_internal(uint64_t tot
         additional_issuance += reserve_reward * (call_duration_height - issued_clocks) / TIMER_BLOCK_HEIGHT_PER_YEAR;
     }
 
-    xinfo("[xzec_reward_contract::calc_issuance] additional_issuance: [%" PRIu64 ", %u], call_duration_height: %" PRId64 ", issued_clocks: %" PRId64 ", total_height: %" PRId64
-          ", current_year: %" PRIu32 ", last_issuance_year: %" PRIu32
-          ", pid: %d"
-          ", reserve_reward: [%llu, %u], last_issuance_time: %llu, issued_until_last_year_end: [%llu, %u], TIMER_BLOCK_HEIGHT_PER_YEAR: %llu",
-          static_cast<uint64_t>(additional_issuance / REWARD_PRECISION),
-          static_cast<uint32_t>(additional_issuance % REWARD_PRECISION),
-          call_duration_height,
-          issued_clocks,
-          total_height,
-          current_year,
-          last_issuance_year,
-          getpid(),
-          static_cast<uint64_t>(reserve_reward / REWARD_PRECISION),
-          static_cast<uint32_t>(reserve_reward % REWARD_PRECISION),
-          last_issuance_time,
-          static_cast<uint64_t>(issued_until_last_year_end / REWARD_PRECISION),
-          static_cast<uint32_t>(issued_until_last_year_end % REWARD_PRECISION),
-          TIMER_BLOCK_HEIGHT_PER_YEAR);
+    auto & audit_log = xreward_audit_log_t::instance();
+    if (audit_log.enabled()) {
+        auto record = audit_record(xreward_audit_record_type_t::issuance, total_height);
+        record.add(audit_value(additional_issuance));
+        record.add(call_duration_height);
+        record.add(issued_clocks);
+        record.add(total_height);
+        record.add(current_year);
+        record.add(last_issuance_year);
+        record.add(audit_value(reserve_reward));
+        record.add(last_issuance_time);
+        record.add(audit_value(issued_until_last_year_end));
+        audit_log.append(m_audit_execution, record);
+    } else {
+        xinfo("[xzec_reward_contract::calc_issuance] additional_issuance: [%" PRIu64 ", %u], call_duration_height: %" PRId64 ", issued_clocks: %" PRId64 ", total_height: %" PRId64
+              ", current_year: %" PRIu32 ", last_issuance_year: %" PRIu32
+              ", pid: %d"
+              ", reserve_reward: [%llu, %u], last_issuance_time: %llu, issued_until_last_year_end: [%llu, %u], TIMER_BLOCK_HEIGHT_PER_YEAR: %llu",
+              static_cast<uint64_t>(additional_issuance / REWARD_PRECISION),
+              static_cast<uint32_t>(additional_issuance % REWARD_PRECISION),
+              call_duration_height,
+              issued_clocks,
+              total_height,
+              current_year,
+              last_issuance_year,
+              getpid(),
+              static_cast<uint64_t>(reserve_reward / REWARD_PRECISION),
+              static_cast<uint32_t>(reserve_reward % REWARD_PRECISION),
+              last_issuance_time,
+              static_cast<uint64_t>(issued_until_last_year_end / REWARD_PRECISION),
+              static_cast<uint32_t>(issued_until_last_year_end % REWARD_PRECISION),
+              TIMER_BLOCK_HEIGHT_PER_YEAR);
+    }
 
     last_issuance_time = total_height;
     return additional_issuance;
@@ -553,9 +683,9 @@ int xzec_reward_contract::get_accumulated_record(xaccumulated_reward_record & re
 }
 
 void xzec_reward_contract::update_accumulated_record(const xaccumulated_reward_record & record) {
-    base::xstream_t stream(base::xcontext_t::instance());
-    record.serialize_to(stream);
-    auto value_str = std::string((char *)stream.data(), stream.size());
+    auto stream = xstream_pool_t::acquire();
+    record.serialize_to(*stream);
+    auto value_str = stream.to_string();
     STRING_SET(XPROPERTY_CONTRACT_ACCUMULATED_ISSUANCE_YEARLY, value_str);
 
     return;
@@ -581,15 +711,18 @@ void xzec_reward_contract::on_receive_workload(std::string const& workload_str)
     MAP_OBJECT_DESERIALZE2(stream, workload_info);
     xdbg("[xzec_reward_contract::on_receive_workload] pid:%d, SOURCE_ADDRESS: %s, workload_info size: %zu\n", getpid(), source_address.c_str(), workload_info.size());
 
+    // every receipt rewrites the whole workload of its clusters
+    std::size_t bytes_written{0};
+    std::string cluster_id;
     for (auto const & workload : workload_info) {
-        xstream_t stream(xcontext_t::instance());
-        stream << workload.first;
-        auto const & cluster_id = std::string((const char *)stream.data(), stream.size());
+        auto stream = xstream_pool_t::acquire();
+        *stream << workload.first;
+        stream.assign_to(cluster_id);
         auto const & workload_info = workload.second;
         if (common::has<common::xnode_type_t::auditor>(workload.first.type())) {
-            add_cluster_workload(true, cluster_id, workload_info.m_leader_count);
+            bytes_written += add_cluster_workload(true, cluster_id, workload_info.m_leader_count);
         } else if (common::has<common::xnode_type_t::validator>(workload.first.type())) {
-            add_cluster_workload(false, cluster_id, workload_info.m_leader_count);
+            bytes_written += add_cluster_workload(false, cluster_id, workload_info.m_leader_count);
         } else {
             // invalid group
             xwarn("[xzec_workload_contract_v2::accumulate_workload] invalid group id: %d", workload.first.group_id().value());
@@ -597,10 +730,12 @@ void xzec_reward_contract::on_receive_workload(std::string const& workload_str)
         }
     }
 
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "workload_receipt_bytes_written", bytes_written);
+    XMETRICS_COUNTER_INCREMENT(XREWARD_CONTRACT "workload_bytes_written", bytes_written);
     XMETRICS_COUNTER_INCREMENT(XREWARD_CONTRACT "on_receive_workload_Executed", 1);
 }
 
-void xzec_reward_contract::add_cluster_workload(bool auditor, std::string const& cluster_id, std::map<std::string, uint32_t> const& leader_count) {
+std::size_t xzec_reward_contract::add_cluster_workload(bool auditor, std::string const& cluster_id, std::map<std::string, uint32_t> const& leader_count) {
     const char* property;
     if (auditor) {
         property = XPORPERTY_CONTRACT_WORKLOAD_KEY;
@@ -652,9 +787,9 @@ void xzec_reward_contract::add_cluster_workload(bool auditor, std::string const&
              workload.cluster_total_workload);
     }
 
-    xstream_t stream(xcontext_t::instance());
-    workload.serialize_to(stream);
-    std::string value = std::string((const char*)stream.data(), stream.size());
+    auto stream = xstream_pool_t::acquire();
+    workload.serialize_to(*stream);
+    std::string value = stream.to_string();
     if (auditor) {
         XMETRICS_TIME_RECORD(XREWARD_CONTRACT "XPORPERTY_CONTRACT_WORKLOAD_KEY_SetExecutionTime");
         MAP_SET(property, cluster_id, value);
@@ -662,6 +797,7 @@ void xzec_reward_contract::add_cluster_workload(bool auditor, std::string const&
         XMETRICS_TIME_RECORD(XREWARD_CONTRACT "XPORPERTY_CONTRACT_VALIDATOR_WORKLOAD_KEY_SetExecutionTime");
         MAP_SET(property, cluster_id, value);
     }
+    return cluster_id.size() + value.size();
 }
 
 void xzec_reward_contract::clear_workload() {
@@ -758,6 +894,35 @@ void xzec_reward_contract::get_reward_param(const common::xlogic_time_t current_
     GET_MAP_PROPERTY(XPORPERTY_CONTRACT_REG_KEY, map_nodes, last_read_height, sys_contract_rec_registration_addr);
     XCONTRACT_ENSURE(map_nodes.size() != 0, "MAP GET PROPERTY XPORPERTY_CONTRACT_REG_KEY empty");
     xdbg("[xzec_reward_contract::get_reward_param] last_read_height: %llu, map_nodes size: %d", last_read_height, map_nodes.size());
+    // get workload
+    std::map<std::string, std::string> auditor_clusters_workloads;
+    std::map<std::string, std::string> validator_clusters_workloads;
+    MAP_COPY_GET(XPORPERTY_CONTRACT_WORKLOAD_KEY, auditor_clusters_workloads);
+    MAP_COPY_GET(XPORPERTY_CONTRACT_VALIDATOR_WORKLOAD_KEY, validator_clusters_workloads);
+    clear_workload();
+    // get vote
+    std::map<std::string, std::string> contract_auditor_votes;
+    MAP_COPY_GET(XPORPERTY_CONTRACT_TICKETS_KEY, contract_auditor_votes, sys_contract_zec_vote_addr);
+    // get accumulated reward
+    std::string value_str = STRING_GET(XPROPERTY_CONTRACT_ACCUMULATED_ISSUANCE_YEARLY);
+    decode_reward_property(map_nodes, auditor_clusters_workloads, validator_clusters_workloads, contract_auditor_votes, value_str, property_param);
+    issue_detail.m_auditor_group_count = property_param.auditor_workloads_detail.size();
+    issue_detail.m_validator_group_count = property_param.validator_workloads_detail.size();
+    xdbg("[xzec_reward_contract::get_reward_param] auditor_group_count: %d", issue_detail.m_auditor_group_count);
+    xdbg("[xzec_reward_contract::get_reward_param] validator_group_count: %d", issue_detail.m_validator_group_count);
+    xdbg("[xzec_reward_contract::get_reward_param] votes_detail_count: %d", property_param.votes_detail.size());
+    xdbg("[xzec_reward_contract::get_reward_param] accumulated_reward_record: %lu, [%lu, %u]",
+         property_param.accumulated_reward_record.last_issuance_time,
+         static_cast<uint64_t>(property_param.accumulated_reward_record.issued_until_last_year_end / xstake::REWARD_PRECISION),
+         static_cast<uint32_t>(property_param.accumulated_reward_record.issued_until_last_year_end % xstake::REWARD_PRECISION));
+}
+
+void xzec_reward_contract::decode_reward_property(std::map<std::string, std::string> const & map_nodes,
+                                                  std::map<std::string, std::string> const & auditor_clusters_workloads,
+                                                  std::map<std::string, std::string> const & validator_clusters_workloads,
+                                                  std::map<std::string, std::string> const & contract_auditor_votes,
+                                                  std::string const & accumulated_record,
+                                                  xreward_property_param_t & property_param) {
     for (auto const & entity : map_nodes) {
         auto const & account = entity.first;
         auto const & value_str = entity.second;
@@ -767,12 +932,6 @@ void xzec_reward_contract::get_reward_param(const common::xlogic_time_t current_
         common::xaccount_address_t address{account};
         property_param.map_nodes[address] = node;
     }
-    // get workload
-    std::map<std::string, std::string> auditor_clusters_workloads;
-    std::map<std::string, std::string> validator_clusters_workloads;
-    MAP_COPY_GET(XPORPERTY_CONTRACT_WORKLOAD_KEY, auditor_clusters_workloads);
-    MAP_COPY_GET(XPORPERTY_CONTRACT_VALIDATOR_WORKLOAD_KEY, validator_clusters_workloads);
-    clear_workload();
     for (auto it = auditor_clusters_workloads.begin(); it != auditor_clusters_workloads.end(); it++) {
         auto const & key_str = it->first;
         common::xcluster_address_t cluster_address;
@@ -795,13 +954,6 @@ void xzec_reward_contract::get_reward_param(const common::xlogic_time_t current_
         workload.serialize_from(stream);
         property_param.validator_workloads_detail[cluster_address] = workload;
     }
-    issue_detail.m_auditor_group_count = property_param.auditor_workloads_detail.size();
-    issue_detail.m_validator_group_count = property_param.validator_workloads_detail.size();
-    xdbg("[xzec_reward_contract::get_reward_param] auditor_group_count: %d", issue_detail.m_auditor_group_count);
-    xdbg("[xzec_reward_contract::get_reward_param] validator_group_count: %d", issue_detail.m_validator_group_count);
-    // get vote
-    std::map<std::string, std::string> contract_auditor_votes;
-    MAP_COPY_GET(XPORPERTY_CONTRACT_TICKETS_KEY, contract_auditor_votes, sys_contract_zec_vote_addr);
     for (auto & contract_auditor_vote : contract_auditor_votes) {
         auto const & contract = contract_auditor_vote.first;
         auto const & auditor_votes_str = contract_auditor_vote.second;
@@ -815,17 +967,11 @@ void xzec_reward_contract::get_reward_param(const common::xlogic_time_t current_
         }
         property_param.votes_detail[address] = votes_detail;
     }
-    xdbg("[xzec_reward_contract::get_reward_param] votes_detail_count: %d", property_param.votes_detail.size());
-    // get accumulated reward
-    std::string value_str = STRING_GET(XPROPERTY_CONTRACT_ACCUMULATED_ISSUANCE_YEARLY);
-    if (value_str.size() != 0) {
-        xstream_t stream(xcontext_t::instance(), (uint8_t *)value_str.c_str(), (uint32_t)value_str.size());
+    property_param.vote_index.build(property_param.votes_detail);
+    if (accumulated_record.size() != 0) {
+        xstream_t stream(xcontext_t::instance(), (uint8_t *)accumulated_record.c_str(), (uint32_t)accumulated_record.size());
         property_param.accumulated_reward_record.serialize_from(stream);
     }
-    xdbg("[xzec_reward_contract::get_reward_param] accumulated_reward_record: %lu, [%lu, %u]",
-         property_param.accumulated_reward_record.last_issuance_time,
-         static_cast<uint64_t>(property_param.accumulated_reward_record.issued_until_last_year_end / xstake::REWARD_PRECISION),
-         static_cast<uint32_t>(property_param.accumulated_reward_record.issued_until_last_year_end % xstake::REWARD_PRECISION));
 }
 
 /**
@@ -952,18 +1098,29 @@ std::vector<std::vector<uint32_t>> xzec_reward_contract::calc_role_nums(std::map
 uint64_t xzec_reward_contract::calc_votes(std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, uint64_t>> const & votes_detail,
                                           std::map<common::xaccount_address_t, xreg_node_info> & map_nodes,
                                           std::map<common::xaccount_address_t, uint64_t> & account_votes) {
+    xvote_index_t vote_index;
+    vote_index.build(votes_detail);
+    return calc_votes(vote_index, map_nodes, account_votes);
+}
+
+std::map<common::xaccount_address_t, uint64_t> xzec_reward_contract::calc_votes(
+    std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, uint64_t>> const & votes_detail,
+    std::map<common::xaccount_address_t, xreg_node_info> const & map_nodes) {
+    xvote_index_t vote_index;
+    vote_index.build(votes_detail);
+    return calc_votes(vote_index, map_nodes);
+}
+
+uint64_t xzec_reward_contract::calc_votes(xvote_index_t const & vote_index,
+                                          std::map<common::xaccount_address_t, xreg_node_info> & map_nodes,
+                                          std::map<common::xaccount_address_t, uint64_t> & account_votes) {
     for (auto & entity : map_nodes) {
         auto const & account = entity.first;
         auto & node = entity.second;
         uint64_t node_total_votes = 0;
-        for (auto const & vote_detail : votes_detail) {
-            auto const & contract = vote_detail.first;
-            auto const & vote = vote_detail.second;
-            auto iter = vote.find(account);
-            if (iter != vote.end()) {
-                account_votes[account] += iter->second;
-                node_total_votes += iter->second;
-            }
+        if (vote_index.voted(account)) {
+            node_total_votes = vote_index.node_total(account);
+            account_votes[account] += node_total_votes;
         }
         node.m_vote_amount = node_total_votes;
         xdbg("[xzec_reward_contract::calc_votes] map_nodes: account: %s, deposit: %llu, node_type: %s, votes: %llu",
@@ -974,42 +1131,29 @@ uint64_t xzec_reward_contract::calc_votes(std::map<common::xaccount_address_t, s
     }
     // valid auditor only
     uint64_t total_votes = 0;
-    for (auto const & entity : votes_detail) {
-        auto const & vote = entity.second;
-
-        for (auto const & entity2 : vote) {
-            xreg_node_info node;
-            auto it = map_nodes.find(common::xaccount_address_t{entity2.first});
-            if (it == map_nodes.end()) {
-                xwarn("[xzec_reward_contract::calc_votes] account %s not in map_nodes", entity2.first.c_str());
-                continue;
-            } else {
-                node = it->second;
-            }
+    vote_index.for_each_node([&](common::xaccount_address_t const & account, uint64_t const votes) {
+        auto it = map_nodes.find(account);
+        if (it == map_nodes.end()) {
+            xwarn("[xzec_reward_contract::calc_votes] account %s not in map_nodes", account.c_str());
+            return;
+        }
 
-            if (node.deposit() > 0 && node.can_be_auditor()) {
-                total_votes += entity2.second;
-            }
+        auto const & node = it->second;
+        if (node.deposit() > 0 && node.can_be_auditor()) {
+            total_votes += votes;
         }
-    }
+    });
 
     return total_votes;
 }
 
-std::map<common::xaccount_address_t, uint64_t> xzec_reward_contract::calc_votes(
-    std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, uint64_t>> const & votes_detail,
-    std::map<common::xaccount_address_t, xreg_node_info> const & map_nodes) {
+std::map<common::xaccount_address_t, uint64_t> xzec_reward_contract::calc_votes(xvote_index_t const & vote_index,
+                                                                                 std::map<common::xaccount_address_t, xreg_node_info> const & map_nodes) {
     std::map<common::xaccount_address_t, uint64_t> account_votes;
-    for (auto & entity : map_nodes) {
+    for (auto const & entity : map_nodes) {
         auto const & account = entity.first;
-        auto & node = entity.second;
-        for (auto const & vote_detail : votes_detail) {
-            auto const & contract = vote_detail.first;
-            auto const & vote = vote_detail.second;
-            auto iter = vote.find(account);
-            if (iter != vote.end()) {
-                account_votes[account] += iter->second;
-            }
+        if (vote_index.voted(account)) {
+            account_votes[account] += vote_index.node_total(account);
         }
     }
 
@@ -1273,22 +1417,32 @@ void xzec_reward_contract::calc_table_node_dividend_detail(common::xaccount_addr
                                                            std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, top::xstake::uint128_t>> & table_node_dividend_detail) {
     auto iter = vote_detail.find(account);
     if (iter != vote_detail.end()) {
-        auto reward_to_voter = reward * iter->second / node_total_votes;
-        xdbg(
-            "[calc_table_node_dividend_detail] account: %s, contract: %s, table votes: %llu, adv_total_votes: %llu, adv_reward_to_voters: [%llu, %u], adv_reward_to_contract: "
-            "[%llu, %u]\n",
-            account.c_str(),
-            iter->first.c_str(),
-            iter->second,
-            node_total_votes,
-            static_cast<uint64_t>(reward / REWARD_PRECISION),
-            static_cast<uint32_t>(reward % REWARD_PRECISION),
-            static_cast<uint64_t>(reward_to_voter / REWARD_PRECISION),
-            static_cast<uint32_t>(reward_to_voter % REWARD_PRECISION));
-        if (reward_to_voter > 0) {
-            table_total_rewards[table_address] += reward_to_voter;
-            table_node_dividend_detail[table_address][account] += reward_to_voter;
-        }
+        calc_table_node_dividend(table_address, account, reward, node_total_votes, iter->second, table_total_rewards, table_node_dividend_detail);
+    }
+}
+
+void xzec_reward_contract::calc_table_node_dividend(common::xaccount_address_t const & table_address,
+                                                    common::xaccount_address_t const & account,
+                                                    top::xstake::uint128_t const & reward,
+                                                    uint64_t node_total_votes,
+                                                    uint64_t voter_tickets,
+                                                    std::map<common::xaccount_address_t, top::xstake::uint128_t> & table_total_rewards,
+                                                    std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, top::xstake::uint128_t>> & table_node_dividend_detail) {
+    auto reward_to_voter = reward * voter_tickets / node_total_votes;
+    xdbg(
+        "[calc_table_node_dividend_detail] account: %s, contract: %s, table votes: %llu, adv_total_votes: %llu, adv_reward_to_voters: [%llu, %u], adv_reward_to_contract: "
+        "[%llu, %u]\n",
+        account.c_str(),
+        table_address.c_str(),
+        voter_tickets,
+        node_total_votes,
+        static_cast<uint64_t>(reward / REWARD_PRECISION),
+        static_cast<uint32_t>(reward % REWARD_PRECISION),
+        static_cast<uint64_t>(reward_to_voter / REWARD_PRECISION),
+        static_cast<uint32_t>(reward_to_voter % REWARD_PRECISION));
+    if (reward_to_voter > 0) {
+        table_total_rewards[table_address] += reward_to_voter;
+        table_node_dividend_detail[table_address][account] += reward_to_voter;
     }
 }
 
@@ -1326,7 +1480,9 @@ void xzec_reward_contract::calc_nodes_rewards_v5(common::xlogic_time_t const cur
                                                  xissue_detail & issue_detail,
                                                  std::map<common::xaccount_address_t, top::xstake::uint128_t> & node_reward_detail,
                                                  std::map<common::xaccount_address_t, top::xstake::uint128_t> & node_dividend_detail,
-                                                 top::xstake::uint128_t & community_reward) {
+                                                 top::xstake::uint128_t & community_reward,
+                                                 xreward_round_timing_t & timing) {
+    auto const begin = std::chrono::steady_clock::now();
     // step 1: calculate issuance
     top::xstake::uint128_t total_issuance =
         calc_total_issuance(issue_time_length, onchain_param.min_ratio_annual_total_reward, onchain_param.additional_issue_year_ratio, property_param.accumulated_reward_record);
@@ -1349,9 +1505,15 @@ void xzec_reward_contract::calc_nodes_rewards_v5(common::xlogic_time_t const cur
         validator_group_workload_rewards = validator_total_workload_rewards / validator_group_count;
     }
 
+    auto const issuance_end = std::chrono::steady_clock::now();
+
     // step 2: calculate different votes and role nums
     std::map<common::xaccount_address_t, uint64_t> account_votes;
-    auto auditor_total_votes = calc_votes(property_param.votes_detail, property_param.map_nodes, account_votes);
+    if (!property_param.vote_index.built()) {
+        property_param.vote_index.build(property_param.votes_detail);
+    }
+    auto auditor_total_votes = calc_votes(property_param.vote_index, property_param.map_nodes, account_votes);
+    auto const votes_end = std::chrono::steady_clock::now();
 
     auto const & fork_config = chain_fork::xchain_fork_config_center_t::get_chain_fork_config();
 #if defined(XENABLE_TESTS)
@@ -1359,46 +1521,74 @@ void xzec_reward_contract::calc_nodes_rewards_v5(common::xlogic_time_t const cur
 #else
     auto const fullnode_enabled = chain_fork::xchain_fork_config_center_t::is_forked(fork_config.enable_fullnode_related_func_fork_point, current_time);
 #endif
-    std::vector<std::vector<uint32_t>> role_nums = calc_role_nums(property_param.map_nodes, fullnode_enabled);
-
-    xinfo(
-        "[xzec_reward_contract::calc_nodes_rewards] issue_time_length: %llu, "
-        "total issuance: [%llu, %u], "
-        "edge workload rewards: [%llu, %u], total edge num: %d, valid edge num: %d, "
-        "archive workload rewards: [%llu, %u], total archive num: %d, valid archive num: %d, "
-        "auditor workload rewards: [%llu, %u], auditor workload grop num: %d, auditor group workload rewards: [%llu, %u], total auditor num: %d, valid auditor num: %d, "
-        "validator workload rewards: [%llu, %u], validator workload grop num: %d, validator group workload rewards: [%llu, %u], total validator num: %d, valid validator num: %d,  "
-        "vote rewards: [%llu, %u], "
-        "governance rewards: [%llu, %u], ",
-        issue_time_length,
-        static_cast<uint64_t>(total_issuance / REWARD_PRECISION),
-        static_cast<uint32_t>(total_issuance % REWARD_PRECISION),
-        static_cast<uint64_t>(edge_workload_rewards / REWARD_PRECISION),
-        static_cast<uint32_t>(edge_workload_rewards % REWARD_PRECISION),
-        role_nums[edger_idx][total_idx],
-        role_nums[edger_idx][valid_idx],
-        static_cast<uint64_t>(archive_workload_rewards / REWARD_PRECISION),
-        static_cast<uint32_t>(archive_workload_rewards % REWARD_PRECISION),
-        role_nums[archiver_idx][total_idx],
-        role_nums[archiver_idx][valid_idx],
-        static_cast<uint64_t>(auditor_total_workload_rewards / REWARD_PRECISION),
-        static_cast<uint32_t>(auditor_total_workload_rewards % REWARD_PRECISION),
-        auditor_group_count,
-        static_cast<uint64_t>(auditor_group_workload_rewards / REWARD_PRECISION),
-        static_cast<uint32_t>(auditor_group_workload_rewards % REWARD_PRECISION),
-        role_nums[auditor_idx][total_idx],
-        role_nums[auditor_idx][valid_idx],
-        static_cast<uint64_t>(validator_total_workload_rewards / REWARD_PRECISION),
-        static_cast<uint32_t>(validator_total_workload_rewards % REWARD_PRECISION),
-        validator_group_count,
-        static_cast<uint64_t>(validator_group_workload_rewards / REWARD_PRECISION),
-        static_cast<uint32_t>(validator_group_workload_rewards % REWARD_PRECISION),
-        role_nums[validator_idx][total_idx],
-        role_nums[validator_idx][valid_idx],
-        static_cast<uint64_t>(vote_rewards / REWARD_PRECISION),
-        static_cast<uint32_t>(vote_rewards % REWARD_PRECISION),
-        static_cast<uint64_t>(governance_rewards / REWARD_PRECISION),
-        static_cast<uint32_t>(governance_rewards % REWARD_PRECISION));
+    auto const role_nums = calc_role_nums(property_param.map_nodes, fullnode_enabled);
+    auto const role_nums_end = std::chrono::steady_clock::now();
+
+    auto & audit_log = xreward_audit_log_t::instance();
+    auto const audit = audit_log.enabled();
+    if (audit) {
+        auto issuance_record = audit_record(xreward_audit_record_type_t::round_issuance, current_time);
+        issuance_record.add(issue_time_length);
+        issuance_record.add(audit_value(total_issuance));
+        issuance_record.add(audit_value(edge_workload_rewards));
+        issuance_record.add(audit_value(archive_workload_rewards));
+        issuance_record.add(audit_value(auditor_total_workload_rewards));
+        issuance_record.add(auditor_group_count);
+        issuance_record.add(audit_value(auditor_group_workload_rewards));
+        issuance_record.add(audit_value(validator_total_workload_rewards));
+        issuance_record.add(validator_group_count);
+        issuance_record.add(audit_value(validator_group_workload_rewards));
+        issuance_record.add(audit_value(vote_rewards));
+        issuance_record.add(audit_value(governance_rewards));
+        audit_log.append(m_audit_execution, issuance_record);
+
+        auto roles_record = audit_record(xreward_audit_record_type_t::round_roles, current_time);
+        for (auto const & nums : role_nums) {
+            for (auto const num : nums) {
+                roles_record.add(num);
+            }
+        }
+        audit_log.append(m_audit_execution, roles_record);
+    } else {
+        xinfo(
+            "[xzec_reward_contract::calc_nodes_rewards] issue_time_length: %llu, "
+            "total issuance: [%llu, %u], "
+            "edge workload rewards: [%llu, %u], total edge num: %d, valid edge num: %d, "
+            "archive workload rewards: [%llu, %u], total archive num: %d, valid archive num: %d, "
+            "auditor workload rewards: [%llu, %u], auditor workload grop num: %d, auditor group workload rewards: [%llu, %u], total auditor num: %d, valid auditor num: %d, "
+            "validator workload rewards: [%llu, %u], validator workload grop num: %d, validator group workload rewards: [%llu, %u], total validator num: %d, valid validator num: %d,  "
+            "vote rewards: [%llu, %u], "
+            "governance rewards: [%llu, %u], ",
+            issue_time_length,
+            static_cast<uint64_t>(total_issuance / REWARD_PRECISION),
+            static_cast<uint32_t>(total_issuance % REWARD_PRECISION),
+            static_cast<uint64_t>(edge_workload_rewards / REWARD_PRECISION),
+            static_cast<uint32_t>(edge_workload_rewards % REWARD_PRECISION),
+            role_nums[edger_idx][total_idx],
+            role_nums[edger_idx][valid_idx],
+            static_cast<uint64_t>(archive_workload_rewards / REWARD_PRECISION),
+            static_cast<uint32_t>(archive_workload_rewards % REWARD_PRECISION),
+            role_nums[archiver_idx][total_idx],
+            role_nums[archiver_idx][valid_idx],
+            static_cast<uint64_t>(auditor_total_workload_rewards / REWARD_PRECISION),
+            static_cast<uint32_t>(auditor_total_workload_rewards % REWARD_PRECISION),
+            auditor_group_count,
+            static_cast<uint64_t>(auditor_group_workload_rewards / REWARD_PRECISION),
+            static_cast<uint32_t>(auditor_group_workload_rewards % REWARD_PRECISION),
+            role_nums[auditor_idx][total_idx],
+            role_nums[auditor_idx][valid_idx],
+            static_cast<uint64_t>(validator_total_workload_rewards / REWARD_PRECISION),
+            static_cast<uint32_t>(validator_total_workload_rewards % REWARD_PRECISION),
+            validator_group_count,
+            static_cast<uint64_t>(validator_group_workload_rewards / REWARD_PRECISION),
+            static_cast<uint32_t>(validator_group_workload_rewards % REWARD_PRECISION),
+            role_nums[validator_idx][total_idx],
+            role_nums[validator_idx][valid_idx],
+            static_cast<uint64_t>(vote_rewards / REWARD_PRECISION),
+            static_cast<uint32_t>(vote_rewards % REWARD_PRECISION),
+            static_cast<uint64_t>(governance_rewards / REWARD_PRECISION),
+            static_cast<uint32_t>(governance_rewards % REWARD_PRECISION));
+    }
     // step 3: calculate reward
     if (0 == role_nums[edger_idx][valid_idx]) {
         community_reward += edge_workload_rewards;
@@ -1423,6 +1613,8 @@ void xzec_reward_contract::calc_nodes_rewards_v5(common::xlogic_time_t const cur
             calc_zero_workload_reward(false, property_param.validator_workloads_detail, onchain_param.validator_group_zero_workload, validator_group_workload_rewards, zero_workload_account);
     }
 
+    auto const zero_workload_end = std::chrono::steady_clock::now();
+
     // TODO: voter to zero workload account has no workload reward
     for (auto const & entity : property_param.map_nodes) {
         auto const & account = entity.first;
@@ -1492,15 +1684,41 @@ void xzec_reward_contract::calc_nodes_rewards_v5(common::xlogic_time_t const cur
             self_reward -= dividend_reward;
         }
         issue_detail.m_node_rewards[account.to_string()].m_self_reward = self_reward;
+        if (audit) {
+            auto const & issue_node_reward = issue_detail.m_node_rewards[account.to_string()];
+            auto record = audit_record(xreward_audit_record_type_t::node_reward, current_time, account.to_string());
+            record.add(audit_value(issue_node_reward.m_edge_reward));
+            record.add(audit_value(issue_node_reward.m_archive_reward));
+            record.add(audit_value(issue_node_reward.m_auditor_reward));
+            record.add(audit_value(issue_node_reward.m_validator_reward));
+            record.add(audit_value(issue_node_reward.m_vote_reward));
+            record.add(audit_value(self_reward));
+            record.add(audit_value(dividend_reward));
+            audit_log.append(m_audit_execution, record);
+        }
         // 3.5 calc table reward
         if (self_reward > 0) {
-            xinfo("[node_reward_detail] acocunt: %s", account.c_str());
+            if (!audit) {
+                xinfo("[node_reward_detail] acocunt: %s", account.c_str());
+            }
             node_reward_detail[account] = self_reward;
         }
         if (dividend_reward > 0) {
             node_dividend_detail[account] = dividend_reward;
         }
     }
+    auto const node_rewards_end = std::chrono::steady_clock::now();
+
+    timing.issuance_us = std::chrono::duration_cast<std::chrono::microseconds>(issuance_end - begin).count();
+    timing.votes_us = std::chrono::duration_cast<std::chrono::microseconds>(votes_end - issuance_end).count();
+    timing.role_nums_us = std::chrono::duration_cast<std::chrono::microseconds>(role_nums_end - votes_end).count();
+    timing.zero_workload_us = std::chrono::duration_cast<std::chrono::microseconds>(zero_workload_end - role_nums_end).count();
+    timing.node_rewards_us = std::chrono::duration_cast<std::chrono::microseconds>(node_rewards_end - zero_workload_end).count();
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "calc_nodes_rewards_issuance_time_us", timing.issuance_us);
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "calc_nodes_rewards_votes_time_us", timing.votes_us);
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "calc_nodes_rewards_role_nums_time_us", timing.role_nums_us);
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "calc_nodes_rewards_zero_workload_time_us", timing.zero_workload_us);
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "calc_nodes_rewards_node_rewards_time_us", timing.node_rewards_us);
     XMETRICS_COUNTER_INCREMENT(XREWARD_CONTRACT "calc_nodes_rewards_Executed", 1);
 }
 
@@ -1510,25 +1728,43 @@ void xzec_reward_contract::calc_table_rewards(xreward_property_param_t & propert
                                               std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, top::xstake::uint128_t>> & table_node_reward_detail,
                                               std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, top::xstake::uint128_t>> & table_node_dividend_detail,
                                               std::map<common::xaccount_address_t, top::xstake::uint128_t> & table_total_rewards) {
+    if (!property_param.vote_index.built()) {
+        property_param.vote_index.build(property_param.votes_detail);
+    }
+    auto const & vote_index = property_param.vote_index;
     std::map<common::xaccount_address_t, uint64_t> account_votes;
-    calc_votes(property_param.votes_detail, property_param.map_nodes, account_votes);
+    calc_votes(vote_index, property_param.map_nodes, account_votes);
+    auto const audit = xreward_audit_log_t::instance().enabled();
     for(auto reward : node_reward_detail){
-        xinfo("[xzec_reward_contract::calc_table_rewards] acocunt: %s", reward.first.c_str());
+        if (!audit) {
+            xinfo("[xzec_reward_contract::calc_table_rewards] acocunt: %s", reward.first.c_str());
+        }
         common::xaccount_address_t table_address = calc_table_contract_address(common::xaccount_address_t{reward.first});
         if(table_address.empty()){
             continue;
         }
         calc_table_node_reward_detail(table_address, reward.first, reward.second, table_total_rewards, table_node_reward_detail);
     }
-    for(auto reward : node_dividend_detail){
-        for (auto & vote_detail : property_param.votes_detail){
-            auto const & voter = vote_detail.first;
-            auto const & votes = vote_detail.second;
-            common::xaccount_address_t table_address = calc_table_contract_address(common::xaccount_address_t{voter});
-            if(table_address.empty()){
+    // table of every voter, resolved once instead of once per node
+    std::vector<common::xaccount_address_t> voter_tables;
+    voter_tables.reserve(vote_index.voters().size());
+    for (auto const & voter : vote_index.voters()) {
+        voter_tables.push_back(calc_table_contract_address(voter));
+    }
+    // only the voters holding tickets of the node are visited, the sums don't depend on the order
+    for (auto const & reward : node_dividend_detail) {
+        auto const & node_voters = vote_index.node_voters(reward.first);
+        if (node_voters.empty()) {
+            continue;
+        }
+        auto const it = account_votes.find(reward.first);
+        auto const node_total_votes = it != account_votes.end() ? it->second : 0;
+        for (auto const & voter_tickets : node_voters) {
+            auto const & table_address = voter_tables[voter_tickets.voter];
+            if (table_address.empty()) {
                 continue;
             }
-            calc_table_node_dividend_detail(table_address, reward.first, reward.second, account_votes[reward.first], votes, table_total_rewards, table_node_dividend_detail);
+            calc_table_node_dividend(table_address, reward.first, reward.second, node_total_votes, voter_tickets.tickets, table_total_rewards, table_node_dividend_detail);
         }
     }
 }
@@ -1538,13 +1774,15 @@ void xzec_reward_contract::dispatch_all_reward_v3(const common::xlogic_time_t cu
                                                   std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, top::xstake::uint128_t>> & table_node_reward_detail,
                                                   std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, top::xstake::uint128_t>> & table_node_dividend_detail,
                                                   top::xstake::uint128_t & community_reward,
-                                                  uint64_t & actual_issuance) {
+                                                  uint64_t & actual_issuance,
+                                                  std::vector<std::string> & tasks) {
     XMETRICS_COUNTER_INCREMENT(XREWARD_CONTRACT "dispatch_all_reward_Called", 1);
     XMETRICS_TIME_RECORD(XREWARD_CONTRACT "dispatch_all_reward");
     xdbg("[xzec_reward_contract::dispatch_all_reward] pid:%d\n", getpid());
+    auto & audit_log = xreward_audit_log_t::instance();
+    auto const audit = audit_log.enabled();
     // dispatch table reward
     uint64_t issuance = 0;
-    uint32_t task_id = get_task_id();
     for (auto const & entity : table_total_rewards) {
         auto const & contract = entity.first;
         auto const & total_award = entity.second;
@@ -1556,86 +1794,46 @@ void xzec_reward_contract::dispatch_all_reward_v3(const common::xlogic_time_t cu
         issuance += reward;
         std::map<std::string, uint64_t> issuances;
         issuances.emplace(contract.to_string(), reward);
-        base::xstream_t seo_stream(base::xcontext_t::instance());
-        seo_stream << issuances;
-
-        add_task(task_id, current_time, "", XTRANSFER_ACTION, std::string((char *)seo_stream.data(), seo_stream.size()));
-        task_id++;
+        if (audit) {
+            auto record = audit_record(xreward_audit_record_type_t::table_reward, current_time, contract.to_string());
+            record.add(audit_value(total_award));
+            record.add(reward);
+            audit_log.append(m_audit_execution, record);
+        }
+        tasks.push_back(make_task(current_time, "", XTRANSFER_ACTION, xstream_pool_t::serialize(issuances)));
     }
     xinfo("[xzec_reward_contract::dispatch_all_reward] actual issuance: %lu", issuance);
     // dispatch community reward
     uint64_t common_funds = static_cast<uint64_t>(community_reward / REWARD_PRECISION);
     if (common_funds > 0) {
-        task_id = get_task_id();
         issuance += common_funds;
         std::map<std::string, uint64_t> issuances;
         issuances.emplace(sys_contract_rec_tcc_addr, common_funds);
-        base::xstream_t seo_stream(base::xcontext_t::instance());
-        seo_stream << issuances;
-
-        add_task(task_id, current_time, "", XTRANSFER_ACTION, std::string((char *)seo_stream.data(), seo_stream.size()));
-        task_id++;
+        tasks.push_back(make_task(current_time, "", XTRANSFER_ACTION, xstream_pool_t::serialize(issuances)));
         xinfo("[xzec_reward_contract::dispatch_all_reward] common_funds: %lu", common_funds);
     }
-    // generate tasks
-    const int task_limit = 1000;
+    // generate tasks, a task holds at most task_max_accounts accounts
+    std::vector<std::string> params;
     xinfo("[xzec_reward_contract::dispatch_all_reward] pid: %d, table_node_reward_detail size: %d\n", getpid(), table_node_reward_detail.size());
-    for (auto & entity : table_node_reward_detail) {
-        auto const & contract = entity.first;
-        auto const & account_awards = entity.second;
-
-        int count = 0;
-        std::map<std::string, top::xstake::uint128_t> account_awards2;
-        for (auto it = account_awards.begin(); it != account_awards.end(); it++) {
-            account_awards2[it->first.to_string()] = it->second;
-            if (++count % task_limit == 0) {
-                base::xstream_t reward_stream(base::xcontext_t::instance());
-                reward_stream << current_time;
-                reward_stream << account_awards2;
-                add_task(task_id, current_time, contract.to_string(), XREWARD_CLAIMING_ADD_NODE_REWARD, std::string((char *)reward_stream.data(), reward_stream.size()));
-                task_id++;
-
-                account_awards2.clear();
-            }
-        }
-        if (account_awards2.size() > 0) {
-            base::xstream_t reward_stream(base::xcontext_t::instance());
-            reward_stream << current_time;
-            reward_stream << account_awards2;
-            add_task(task_id, current_time, contract.to_string(), XREWARD_CLAIMING_ADD_NODE_REWARD, std::string((char *)reward_stream.data(), reward_stream.size()));
-            task_id++;
+    for (auto const & entity : table_node_reward_detail) {
+        params.clear();
+        xreward_task_params_t::encode(current_time, entity.second, task_max_accounts, params);
+        for (auto const & param : params) {
+            tasks.push_back(make_task(current_time, entity.first.to_string(), XREWARD_CLAIMING_ADD_NODE_REWARD, param));
         }
     }
     xinfo("[xzec_reward_contract::dispatch_all_reward] pid: %d, table_node_dividend_detail size: %d\n", getpid(), table_node_dividend_detail.size());
     for (auto const & entity : table_node_dividend_detail) {
-        auto const & contract = entity.first;
-        auto const & auditor_vote_rewards = entity.second;
-
-        int count = 0;
-        std::map<std::string, top::xstake::uint128_t> auditor_vote_rewards2;
-        for (auto it = auditor_vote_rewards.begin(); it != auditor_vote_rewards.end(); it++) {
-            auditor_vote_rewards2[it->first.to_string()] = it->second;
-            if (++count % task_limit == 0) {
-                base::xstream_t reward_stream(base::xcontext_t::instance());
-                reward_stream << current_time;
-                reward_stream << auditor_vote_rewards2;
-                add_task(task_id, current_time, contract.to_string(), XREWARD_CLAIMING_ADD_VOTER_DIVIDEND_REWARD, std::string((char *)reward_stream.data(), reward_stream.size()));
-                task_id++;
-
-                auditor_vote_rewards2.clear();
-            }
-        }
-        if (auditor_vote_rewards2.size() > 0) {
-            base::xstream_t reward_stream(base::xcontext_t::instance());
-            reward_stream << current_time;
-            reward_stream << auditor_vote_rewards2;
-            add_task(task_id, current_time, contract.to_string(), XREWARD_CLAIMING_ADD_VOTER_DIVIDEND_REWARD, std::string((char *)reward_stream.data(), reward_stream.size()));
-            task_id++;
+        params.clear();
+        xreward_task_params_t::encode(current_time, entity.second, task_max_accounts, params);
+        for (auto const & param : params) {
+            tasks.push_back(make_task(current_time, entity.first.to_string(), XREWARD_CLAIMING_ADD_VOTER_DIVIDEND_REWARD, param));
         }
     }
 
+    XMETRICS_COUNTER_SET(XREWARD_CONTRACT "task_enqueued_per_round", tasks.size());
+
     actual_issuance = issuance;
-    print_tasks();
 
     XMETRICS_COUNTER_INCREMENT(XREWARD_CONTRACT "dispatch_all_reward_Executed", 1);
     return;
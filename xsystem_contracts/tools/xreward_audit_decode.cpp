@@ -0,0 +1,115 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// print a reward audit log written by xreward_audit_log_t as one text line per record
+// usage: xreward_audit_decode [--dedup] <file> [<file> ...]
+// with --dedup only the first execution logged of every block is printed, the records logged again when the
+// block was re-executed for another proposal are skipped. pass rotated files oldest first.
+
+#include "xvm/xsystem_contracts/xreward/xreward_audit_record.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <vector>
+
+using top::xstake::xreward_audit_record_t;
+using top::xstake::xreward_audit_record_type_t;
+
+static char const * type_name(xreward_audit_record_type_t type) {
+    switch (type) {
+    case xreward_audit_record_type_t::round_issuance:
+        return "round_issuance";
+    case xreward_audit_record_type_t::round_roles:
+        return "round_roles";
+    case xreward_audit_record_type_t::node_reward:
+        return "node_reward";
+    case xreward_audit_record_type_t::issuance_year:
+        return "issuance_year";
+    case xreward_audit_record_type_t::issuance:
+        return "issuance";
+    case xreward_audit_record_type_t::table_reward:
+        return "table_reward";
+    case xreward_audit_record_type_t::task:
+        return "task";
+    default:
+        return "unknown";
+    }
+}
+
+// block height => the execution whose records are printed, only filled with --dedup
+static std::map<uint64_t, uint64_t> printed_executions;
+
+static bool skip_duplicate(xreward_audit_record_t const & record) {
+    if (record.block_height == 0) {
+        return false;
+    }
+    auto const it = printed_executions.emplace(record.block_height, record.execution).first;
+    return it->second != record.execution;
+}
+
+static int decode_file(char const * path, bool dedup) {
+    std::FILE * file = std::fopen(path, "rb");
+    if (file == nullptr) {
+        std::fprintf(stderr, "%s: cannot open\n", path);
+        return 1;
+    }
+
+    std::vector<uint8_t> buffer(xreward_audit_record_t::max_encoded_size);
+    int result = 0;
+    if (std::fread(buffer.data(), 1, xreward_audit_record_t::file_header_size, file) != xreward_audit_record_t::file_header_size ||
+        !xreward_audit_record_t::check_file_header(buffer.data())) {
+        std::fprintf(stderr, "%s: not a reward audit log of version %u\n", path, static_cast<unsigned>(xreward_audit_record_t::version));
+        result = 1;
+    } else {
+        xreward_audit_record_t record;
+        uint64_t index{0};
+        while (std::fread(buffer.data(), 1, xreward_audit_record_t::header_size, file) == xreward_audit_record_t::header_size) {
+            auto const size = xreward_audit_record_t::encoded_size(buffer.data());
+            if (size == 0 || std::fread(buffer.data() + xreward_audit_record_t::header_size, 1, size - xreward_audit_record_t::header_size, file) !=
+                                 size - xreward_audit_record_t::header_size ||
+                !record.decode(buffer.data(), size)) {
+                std::fprintf(stderr, "%s: record %" PRIu64 " malformed\n", path, index);
+                result = 1;
+                break;
+            }
+            ++index;
+            if (dedup && skip_duplicate(record)) {
+                continue;
+            }
+            std::printf("%s block=%" PRIu64 " execution=%" PRIx64 " round=%" PRIu64 " type=%s account=%s",
+                        path,
+                        record.block_height,
+                        record.execution,
+                        record.round,
+                        type_name(record.type),
+                        record.account.empty() ? "-" : record.account.c_str());
+            for (std::size_t i = 0; i < record.value_count; ++i) {
+                std::printf(" [%" PRIu64 ", %" PRIu32 "]", record.values[i].whole, record.values[i].fraction);
+            }
+            std::printf("\n");
+        }
+    }
+    std::fclose(file);
+    return result;
+}
+
+int main(int argc, char ** argv) {
+    int first = 1;
+    bool dedup = false;
+    if (argc > 1 && std::strcmp(argv[1], "--dedup") == 0) {
+        dedup = true;
+        ++first;
+    }
+    if (argc <= first) {
+        std::fprintf(stderr, "usage: %s [--dedup] <file> [<file> ...]\n", argv[0]);
+        return 2;
+    }
+    int result = 0;
+    for (int i = first; i < argc; ++i) {
+        result |= decode_file(argv[i], dedup);
+    }
+    return result;
+}
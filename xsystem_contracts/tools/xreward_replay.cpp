@@ -0,0 +1,148 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// replay reward rounds of xzec_reward_contract offline and print the time of every phase and the peak memory
+// usage: xreward_replay <dataset> [--rounds <n>]
+//        xreward_replay --synthetic <nodes> <voters> [--seed <seed>] [--save <dataset>] [--rounds <n>]
+
+#include "xbase/xbase.h"
+#include "xvm/xsystem_contracts/tools/xreward_replay_dataset.h"
+#include "xvm/xsystem_contracts/xreward/xzec_reward_contract.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+
+#include <sys/resource.h>
+
+using top::xstake::xreward_onchain_param_t;
+using top::xstake::xreward_property_param_t;
+using top::xstake::xreward_replay_context_t;
+using top::xstake::xreward_replay_dataset_t;
+using top::xstake::xreward_round_result_t;
+using top::xstake::xzec_reward_contract;
+
+static int usage(char const * name) {
+    std::fprintf(stderr, "usage: %s <dataset> [--rounds <n>]\n", name);
+    std::fprintf(stderr, "       %s --synthetic <nodes> <voters> [--seed <seed>] [--save <dataset>] [--rounds <n>]\n", name);
+    return 2;
+}
+
+static uint64_t elapsed_us(std::chrono::steady_clock::time_point const begin) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count());
+}
+
+static long peak_rss_kb() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+    return usage.ru_maxrss;
+}
+
+static void replay_round(std::size_t index, xreward_replay_dataset_t const & dataset, xreward_replay_context_t & context) {
+    auto const begin = std::chrono::steady_clock::now();
+    top::common::xlogic_time_t activation_time{0};
+    xreward_onchain_param_t onchain_param;
+    xreward_property_param_t property_param;
+    top::xstake::xissue_detail issue_detail;
+    context.get_reward_param(activation_time, onchain_param, property_param, issue_detail);
+    auto const param_load_us = elapsed_us(begin);
+
+    xzec_reward_contract contract{top::common::xnetwork_id_t{top::base::enum_main_chain_id}};
+    xreward_round_result_t result;
+    contract.calc_reward_round(dataset.current_time, activation_time, onchain_param, property_param, issue_detail, result);
+    context.add_tasks(result.tasks);
+    auto const total_us = elapsed_us(begin);
+
+    auto const & timing = result.timing;
+    std::printf("round %zu: param_load=%" PRIu64 "us role_counting=%" PRIu64 "us node_rewards=%" PRIu64 "us table_rewards=%" PRIu64 "us dispatch=%" PRIu64
+                "us total=%" PRIu64 "us\n",
+                index,
+                param_load_us,
+                timing.role_nums_us,
+                timing.issuance_us + timing.votes_us + timing.zero_workload_us + timing.node_rewards_us,
+                timing.table_rewards_us,
+                timing.dispatch_us,
+                total_us);
+    std::printf("    node_rewards: issuance=%" PRIu64 "us votes=%" PRIu64 "us zero_workload=%" PRIu64 "us per_node=%" PRIu64 "us\n",
+                timing.issuance_us,
+                timing.votes_us,
+                timing.zero_workload_us,
+                timing.node_rewards_us);
+    std::printf("    nodes=%zu voters=%zu rewarded=%zu dividends=%zu tables=%zu tasks=%zu actual_issuance=%" PRIu64 " peak_rss=%ldKB\n",
+                property_param.map_nodes.size(),
+                property_param.vote_index.voters().size(),
+                result.node_reward_detail.size(),
+                result.node_dividend_detail.size(),
+                result.contract_rewards.size(),
+                result.tasks.size(),
+                result.actual_issuance,
+                peak_rss_kb());
+}
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        return usage(argv[0]);
+    }
+
+    bool const synthetic = std::strcmp(argv[1], "--synthetic") == 0;
+    int i = synthetic ? 4 : 2;
+    if (i > argc) {
+        return usage(argv[0]);
+    }
+    std::size_t rounds{1};
+    uint32_t seed{1};
+    std::string save_path;
+    for (; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            return usage(argv[0]);
+        }
+        if (std::strcmp(argv[i], "--rounds") == 0) {
+            rounds = static_cast<std::size_t>(std::strtoull(argv[i + 1], nullptr, 10));
+        } else if (synthetic && std::strcmp(argv[i], "--seed") == 0) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        } else if (synthetic && std::strcmp(argv[i], "--save") == 0) {
+            save_path = argv[i + 1];
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    xreward_replay_dataset_t dataset;
+    std::string error;
+    auto const begin = std::chrono::steady_clock::now();
+    if (synthetic) {
+        auto const nodes = static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10));
+        auto const voters = static_cast<std::size_t>(std::strtoull(argv[3], nullptr, 10));
+        dataset = xreward_replay_dataset_t::make_synthetic(nodes, voters, seed);
+        std::printf("synthetic dataset: nodes=%zu voters=%zu seed=%" PRIu32 " made in %" PRIu64 "us\n", nodes, voters, seed, elapsed_us(begin));
+    } else {
+        if (!dataset.load(argv[1], error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        std::printf("dataset %s: nodes=%zu voters=%zu read in %" PRIu64 "us\n", argv[1], dataset.reg_nodes.size(), dataset.tickets.size(), elapsed_us(begin));
+    }
+    if (!save_path.empty() && !dataset.save(save_path, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    xreward_replay_context_t context{dataset};
+    try {
+        for (std::size_t round = 0; round < rounds; ++round) {
+            replay_round(round, dataset, context);
+        }
+    } catch (std::exception const & e) {
+        std::fprintf(stderr, "reward round failed: %s\n", e.what());
+        return 1;
+    }
+    std::printf("tasks queued=%zu peak_rss=%ldKB\n", context.tasks().size(), peak_rss_kb());
+    return 0;
+}
@@ -0,0 +1,264 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvm/xsystem_contracts/tools/xreward_replay_dataset.h"
+
+#include "xbase/xbase.h"
+#include "xbase/xcontext.h"
+#include "xbase/xmem.h"
+#include "xbase/xutl.h"
+
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+
+NS_BEG2(top, xstake)
+
+using top::base::xcontext_t;
+using top::base::xstream_t;
+
+constexpr uint32_t xreward_replay_dataset_t::version;
+
+static void write_onchain_param(xstream_t & stream, xreward_onchain_param_t const & param) {
+    stream << param.min_ratio_annual_total_reward;
+    stream << param.additional_issue_year_ratio;
+    stream << param.edge_reward_ratio;
+    stream << param.archive_reward_ratio;
+    stream << param.validator_reward_ratio;
+    stream << param.auditor_reward_ratio;
+    stream << param.vote_reward_ratio;
+    stream << param.governance_reward_ratio;
+    stream << param.auditor_group_zero_workload;
+    stream << param.validator_group_zero_workload;
+}
+
+static void read_onchain_param(xstream_t & stream, xreward_onchain_param_t & param) {
+    stream >> param.min_ratio_annual_total_reward;
+    stream >> param.additional_issue_year_ratio;
+    stream >> param.edge_reward_ratio;
+    stream >> param.archive_reward_ratio;
+    stream >> param.validator_reward_ratio;
+    stream >> param.auditor_reward_ratio;
+    stream >> param.vote_reward_ratio;
+    stream >> param.governance_reward_ratio;
+    stream >> param.auditor_group_zero_workload;
+    stream >> param.validator_group_zero_workload;
+}
+
+bool xreward_replay_dataset_t::load(std::string const & path, std::string & error) {
+    std::FILE * file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::string content;
+    char buffer[64 * 1024];
+    std::size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        content.append(buffer, read);
+    }
+    std::fclose(file);
+
+    try {
+        xstream_t stream(xcontext_t::instance(), (uint8_t *)content.data(), static_cast<uint32_t>(content.size()));
+        uint32_t file_version{0};
+        stream >> file_version;
+        if (file_version != version) {
+            error = path + " is not a reward replay dataset of version " + std::to_string(version);
+            return false;
+        }
+        stream >> current_time;
+        stream >> activation_time;
+        read_onchain_param(stream, onchain_param);
+        stream >> last_read_height;
+        stream >> reg_nodes;
+        stream >> auditor_workloads;
+        stream >> validator_workloads;
+        stream >> tickets;
+        stream >> accumulated_record;
+        if (stream.size() != 0) {
+            error = path + " has " + std::to_string(stream.size()) + " trailing bytes";
+            return false;
+        }
+    } catch (std::exception const & e) {
+        error = path + " is malformed: " + e.what();
+        return false;
+    }
+    return true;
+}
+
+bool xreward_replay_dataset_t::save(std::string const & path, std::string & error) const {
+    xstream_t stream(xcontext_t::instance());
+    stream << version;
+    stream << current_time;
+    stream << activation_time;
+    write_onchain_param(stream, onchain_param);
+    stream << last_read_height;
+    stream << reg_nodes;
+    stream << auditor_workloads;
+    stream << validator_workloads;
+    stream << tickets;
+    stream << accumulated_record;
+
+    std::FILE * file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        error = "cannot create " + path;
+        return false;
+    }
+    auto const size = static_cast<std::size_t>(stream.size());
+    auto const written = std::fwrite(stream.data(), 1, size, file);
+    if (std::fclose(file) != 0 || written != size) {
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+static std::string synthetic_account(std::mt19937 & random) {
+    static char const hex[] = "0123456789abcdef";
+    std::string account{"T80000"};
+    for (std::size_t i = 0; i < 40; ++i) {
+        account.push_back(hex[random() % 16]);
+    }
+    return account;
+}
+
+static std::string serialized_cluster_id(common::xgroup_id_t const & group_id) {
+    common::xcluster_address_t cluster_address{common::xnetwork_id_t{base::enum_main_chain_id}, common::xconsensus_zone_id, common::xdefault_cluster_id, group_id};
+    xstream_t stream(xcontext_t::instance());
+    stream << cluster_address;
+    return std::string{reinterpret_cast<char const *>(stream.data()), static_cast<std::size_t>(stream.size())};
+}
+
+/**
+ * @brief workload of groups_count groups starting at first_group_id, the leaders are dealt to the groups in turn
+ */
+static void make_synthetic_workloads(std::vector<std::string> const & leaders,
+                                     uint8_t first_group_id,
+                                     std::size_t groups_count,
+                                     std::mt19937 & random,
+                                     std::map<std::string, std::string> & workloads) {
+    std::vector<cluster_workload_t> groups(groups_count);
+    for (std::size_t i = 0; i < groups_count; ++i) {
+        groups[i].cluster_id = serialized_cluster_id(common::xgroup_id_t{static_cast<uint8_t>(first_group_id + i)});
+    }
+    for (std::size_t i = 0; i < leaders.size(); ++i) {
+        auto & group = groups[i % groups_count];
+        auto const count = static_cast<uint32_t>(random() % 100 + 1);
+        group.m_leader_count[leaders[i]] += count;
+        group.cluster_total_workload += count;
+    }
+    for (auto & group : groups) {
+        if (group.m_leader_count.empty()) {
+            continue;
+        }
+        xstream_t stream(xcontext_t::instance());
+        group.serialize_to(stream);
+        workloads[group.cluster_id] = std::string{reinterpret_cast<char const *>(stream.data()), static_cast<std::size_t>(stream.size())};
+    }
+}
+
+xreward_replay_dataset_t xreward_replay_dataset_t::make_synthetic(std::size_t node_count, std::size_t voter_count, uint32_t seed) {
+    std::mt19937 random{seed};
+    xreward_replay_dataset_t dataset;
+    dataset.activation_time = 1;
+    dataset.current_time = dataset.activation_time + 30 * 24 * 360;   // a month of 10 second rounds
+    dataset.onchain_param.min_ratio_annual_total_reward = 2;
+    dataset.onchain_param.additional_issue_year_ratio = 50;
+    dataset.onchain_param.edge_reward_ratio = 2;
+    dataset.onchain_param.archive_reward_ratio = 4;
+    dataset.onchain_param.validator_reward_ratio = 60;
+    dataset.onchain_param.auditor_reward_ratio = 10;
+    dataset.onchain_param.vote_reward_ratio = 20;
+    dataset.onchain_param.governance_reward_ratio = 4;
+    dataset.onchain_param.auditor_group_zero_workload = 0;
+    dataset.onchain_param.validator_group_zero_workload = 0;
+    dataset.last_read_height = 1;
+
+    static common::xminer_type_t const miner_types[] = {
+        common::xminer_type_t::advance, common::xminer_type_t::validator, common::xminer_type_t::edge, common::xminer_type_t::archive};
+    std::vector<std::string> advances;
+    std::vector<std::string> validators;
+    for (std::size_t i = 0; i < node_count; ++i) {
+        auto const account = synthetic_account(random);
+        xreg_node_info node;
+        node.m_account = common::xaccount_address_t{account};
+        node.miner_type(miner_types[i % 4]);
+        node.m_account_mortgage = (random() % 1000 + 1) * 1000000000ULL;
+        node.m_support_ratio_numerator = random() % 101;
+        node.m_network_ids.insert(common::xnetwork_id_t{base::enum_main_chain_id});
+        node.m_genesis_node = false;
+
+        xstream_t stream(xcontext_t::instance());
+        node.serialize_to(stream);
+        dataset.reg_nodes[account] = std::string{reinterpret_cast<char const *>(stream.data()), static_cast<std::size_t>(stream.size())};
+        if (miner_types[i % 4] == common::xminer_type_t::advance) {
+            advances.push_back(account);
+        } else if (miner_types[i % 4] == common::xminer_type_t::validator) {
+            validators.push_back(account);
+        }
+    }
+
+    // advance nodes lead the auditor groups and the validator groups, validator nodes only the latter
+    std::vector<std::string> validator_leaders{advances};
+    validator_leaders.insert(validator_leaders.end(), validators.begin(), validators.end());
+    make_synthetic_workloads(advances, common::xauditor_group_id_begin.value(), 2, random, dataset.auditor_workloads);
+    make_synthetic_workloads(validator_leaders, common::xvalidator_group_id_begin.value(), 4, random, dataset.validator_workloads);
+
+    if (!advances.empty()) {
+        for (std::size_t i = 0; i < voter_count; ++i) {
+            std::map<std::string, std::string> votes;
+            auto const voted = random() % 4 + 1;
+            for (std::size_t j = 0; j < voted; ++j) {
+                votes[advances[random() % advances.size()]] = std::to_string(random() % 10000 + 1);
+            }
+            xstream_t stream(xcontext_t::instance());
+            stream << votes;
+            dataset.tickets[synthetic_account(random)] = std::string{reinterpret_cast<char const *>(stream.data()), static_cast<std::size_t>(stream.size())};
+        }
+    }
+    return dataset;
+}
+
+xtop_reward_replay_context::xtop_reward_replay_context(xreward_replay_dataset_t const & dataset) : m_dataset{dataset} {
+}
+
+void xtop_reward_replay_context::get_reward_param(common::xlogic_time_t & activation_time,
+                                                  xreward_onchain_param_t & onchain_param,
+                                                  xreward_property_param_t & property_param,
+                                                  xissue_detail & issue_detail) const {
+    activation_time = m_dataset.activation_time;
+    onchain_param = m_dataset.onchain_param;
+    issue_detail.onchain_timer_round = m_dataset.current_time;
+    issue_detail.m_edge_reward_ratio = onchain_param.edge_reward_ratio;
+    issue_detail.m_archive_reward_ratio = onchain_param.archive_reward_ratio;
+    issue_detail.m_validator_reward_ratio = onchain_param.validator_reward_ratio;
+    issue_detail.m_auditor_reward_ratio = onchain_param.auditor_reward_ratio;
+    issue_detail.m_vote_reward_ratio = onchain_param.vote_reward_ratio;
+    issue_detail.m_governance_reward_ratio = onchain_param.governance_reward_ratio;
+
+    if (m_dataset.reg_nodes.empty()) {
+        throw std::runtime_error{"no registered node"};
+    }
+    xzec_reward_contract::decode_reward_property(m_dataset.reg_nodes,
+                                                 m_dataset.auditor_workloads,
+                                                 m_dataset.validator_workloads,
+                                                 m_dataset.tickets,
+                                                 m_dataset.accumulated_record,
+                                                 property_param);
+    issue_detail.m_auditor_group_count = property_param.auditor_workloads_detail.size();
+    issue_detail.m_validator_group_count = property_param.validator_workloads_detail.size();
+}
+
+void xtop_reward_replay_context::add_tasks(std::vector<std::string> const & tasks) {
+    for (auto const & task : tasks) {
+        m_tasks.emplace(m_next_task_id++, task);
+    }
+}
+
+std::map<uint64_t, std::string> const & xtop_reward_replay_context::tasks() const noexcept {
+    return m_tasks;
+}
+
+NS_END2
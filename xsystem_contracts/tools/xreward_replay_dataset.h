@@ -0,0 +1,111 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+#include "xcommon/xlogic_time.h"
+#include "xstake/xstake_algorithm.h"
+#include "xvm/xsystem_contracts/xreward/xzec_reward_contract.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+NS_BEG2(top, xstake)
+
+/**
+ * @brief inputs of one reward round, kept as the raw property values the reward contract reads. a dataset
+ *        is made up by make_synthetic and can be saved and loaded to replay the same round again.
+ */
+struct xreward_replay_dataset_t {
+    static constexpr uint32_t version{1};
+
+    common::xlogic_time_t current_time{0};
+    common::xlogic_time_t activation_time{0};  // activation_time of XPORPERTY_CONTRACT_GENESIS_STAGE_KEY
+    xreward_onchain_param_t onchain_param{};
+    uint64_t last_read_height{0};   // XPROPERTY_LAST_READ_REC_REG_CONTRACT_BLOCK_HEIGHT
+    std::map<std::string, std::string> reg_nodes;   // XPORPERTY_CONTRACT_REG_KEY of the registration contract at last_read_height
+    std::map<std::string, std::string> auditor_workloads;   // cluster id => serialized cluster_workload_t
+    std::map<std::string, std::string> validator_workloads;   // cluster id => serialized cluster_workload_t
+    std::map<std::string, std::string> tickets;   // XPORPERTY_CONTRACT_TICKETS_KEY of the zec vote contract
+    std::string accumulated_record;   // XPROPERTY_CONTRACT_ACCUMULATED_ISSUANCE_YEARLY, empty in the first year
+
+    /**
+     * @brief read a dataset written by save
+     *
+     * @param path the dataset file
+     * @param error why the file was not read
+     * @return true the dataset is read
+     */
+    bool load(std::string const & path, std::string & error);
+
+    /**
+     * @brief write the dataset, all values in xstream_t encoding after a version
+     *
+     * @param path the dataset file
+     * @param error why the file was not written
+     * @return true the dataset is written
+     */
+    bool save(std::string const & path, std::string & error) const;
+
+    /**
+     * @brief make a dataset of node_count registered nodes rotating through the miner types and
+     *        voter_count voters each voting for up to four advance nodes. the same seed makes the same dataset.
+     *
+     * @param node_count registered nodes
+     * @param voter_count voters
+     * @param seed random seed
+     * @return xreward_replay_dataset_t
+     */
+    static xreward_replay_dataset_t make_synthetic(std::size_t node_count, std::size_t voter_count, uint32_t seed);
+};
+
+/**
+ * @brief an in memory reward contract context: serves the reward params from a dataset, decoded by the
+ *        same xzec_reward_contract::decode_reward_property get_reward_param uses, and keeps the dispatched
+ *        tasks as the task map would.
+ */
+class xtop_reward_replay_context {
+public:
+    xtop_reward_replay_context(xtop_reward_replay_context const &) = delete;
+    xtop_reward_replay_context & operator=(xtop_reward_replay_context const &) = delete;
+    xtop_reward_replay_context(xtop_reward_replay_context &&) = delete;
+    xtop_reward_replay_context & operator=(xtop_reward_replay_context &&) = delete;
+    ~xtop_reward_replay_context() = default;
+
+    explicit xtop_reward_replay_context(xreward_replay_dataset_t const & dataset);
+
+    /**
+     * @brief decode the reward params of the dataset
+     *
+     * @param activation_time system activation time
+     * @param onchain_param onchain params
+     * @param property_param property params
+     * @param issue_detail issuance detail this time
+     */
+    void get_reward_param(common::xlogic_time_t & activation_time,
+                          xreward_onchain_param_t & onchain_param,
+                          xreward_property_param_t & property_param,
+                          xissue_detail & issue_detail) const;
+
+    /**
+     * @brief queue the tasks of a round, ids go on from the last queued task
+     *
+     * @param tasks serialized tasks
+     */
+    void add_tasks(std::vector<std::string> const & tasks);
+
+    std::map<uint64_t, std::string> const & tasks() const noexcept;
+
+private:
+    xreward_replay_dataset_t const & m_dataset;
+    std::map<uint64_t, std::string> m_tasks;
+    uint64_t m_next_task_id{0};
+};
+using xreward_replay_context_t = xtop_reward_replay_context;
+
+NS_END2
@@ -0,0 +1,64 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xcommon/xaddress.h"
+#include "xstake/xstake_algorithm.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+NS_BEG2(top, xstake)
+
+struct xreg_node_record_t {
+    common::xaccount_address_t account;
+    xreg_node_info node;
+};
+
+/**
+ * @brief decode a whole registration map (or one shard of it) into a contiguous vector.
+ *        the decoder keeps its vector between calls, so decoding the same node set round after
+ *        round reuses the vector's buffer. the records themselves are decoded afresh every call.
+ */
+class xtop_reg_node_decoder {
+public:
+    xtop_reg_node_decoder() = default;
+    xtop_reg_node_decoder(xtop_reg_node_decoder const &) = delete;
+    xtop_reg_node_decoder & operator=(xtop_reg_node_decoder const &) = delete;
+    xtop_reg_node_decoder(xtop_reg_node_decoder &&) = default;
+    xtop_reg_node_decoder & operator=(xtop_reg_node_decoder &&) = default;
+    ~xtop_reg_node_decoder() = default;
+
+    /**
+     * @brief decode the registration map, records keep the map's key order
+     *
+     * @param reg_map  account string => serialized xreg_node_info, as read from XPORPERTY_CONTRACT_REG_KEY
+     * @param append  append to the records of the previous call instead of replacing them, used to decode shard by shard
+     * @return std::vector<xreg_node_record_t> const&  the decoded records, valid until the next decode or clear
+     */
+    std::vector<xreg_node_record_t> const & decode(std::map<std::string, std::string> const & reg_map, bool append = false);
+
+    std::vector<xreg_node_record_t> const & records() const noexcept;
+
+    /**
+     * @brief drop the records, the vector capacity is kept
+     *
+     */
+    void clear();
+
+    /**
+     * @brief decoder owned by the calling thread, so the vector survives contract instance clones
+     *
+     * @return xtop_reg_node_decoder&
+     */
+    static xtop_reg_node_decoder & thread_instance();
+
+private:
+    std::vector<xreg_node_record_t> m_records;
+};
+using xreg_node_decoder_t = xtop_reg_node_decoder;
+
+NS_END2
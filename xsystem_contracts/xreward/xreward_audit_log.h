@@ -0,0 +1,127 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+#include "xvm/xsystem_contracts/xreward/xreward_audit_record.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+NS_BEG2(top, xstake)
+
+/**
+ * @brief the contract execution records are made in, kept by the contract instance running it
+ */
+struct xreward_audit_execution_t {
+    uint64_t block_height{0};
+    uint64_t execution{0};
+};
+
+/**
+ * @brief binary audit log of the reward computation, written to a rotating local file.
+ *        records are encoded into a buffer on the calling thread, a full buffer or one flushed is handed to
+ *        a writer thread, so the contract execution does no text formatting and no file io. the log is
+ *        enabled by setting the config key "reward_audit_log_path", otherwise the reward contract keeps
+ *        its text logs. a full file is renamed to <path>.1 (and older ones shifted up to <path>.<max_files - 1>).
+ */
+class xtop_reward_audit_log {
+public:
+    static constexpr std::size_t default_max_file_bytes{64 * 1024 * 1024};
+    static constexpr std::size_t default_max_files{4};
+    static constexpr std::size_t buffer_bytes{64 * 1024};
+    static constexpr std::size_t max_pending_bytes{16 * 1024 * 1024};
+
+    xtop_reward_audit_log(xtop_reward_audit_log const &) = delete;
+    xtop_reward_audit_log & operator=(xtop_reward_audit_log const &) = delete;
+    xtop_reward_audit_log(xtop_reward_audit_log &&) = delete;
+    xtop_reward_audit_log & operator=(xtop_reward_audit_log &&) = delete;
+    ~xtop_reward_audit_log();
+
+    static xtop_reward_audit_log & instance();
+
+    /**
+     * @brief write to path instead of the configured one, an empty path disables the log
+     *
+     * @param path the log file
+     * @param max_file_bytes size a file is rotated at
+     * @param max_files number of files kept, including the one written
+     */
+    void open(std::string const & path, std::size_t max_file_bytes = default_max_file_bytes, std::size_t max_files = default_max_files);
+
+    bool enabled();
+
+    /**
+     * @brief number a new contract execution
+     *
+     * @param block_height height of the block the execution makes
+     * @return xreward_audit_execution_t the execution to tag its records with
+     */
+    static xreward_audit_execution_t begin_execution(uint64_t block_height);
+
+    /**
+     * @brief append a record tagged with an execution, dropped if the log is disabled
+     *
+     * @param execution the execution the record is made in
+     * @param record the record
+     */
+    void append(xreward_audit_execution_t const & execution, xreward_audit_record_t const & record);
+
+    /**
+     * @brief hand the buffered records to the writer thread, which writes and flushes them to the file
+     *
+     */
+    void flush();
+
+private:
+    struct xpending_chunk_t {
+        std::string path;
+        std::size_t max_file_bytes;
+        std::size_t max_files;
+        std::size_t records;
+        bool flush;
+        std::vector<uint8_t> bytes;
+    };
+
+    xtop_reward_audit_log() = default;
+
+    void configure();
+    void hand_off(bool flush);
+    void run_writer();
+    void write_chunk(xpending_chunk_t const & chunk);
+    bool open_file();
+    void rotate();
+
+    // guarded by m_mutex
+    std::mutex m_mutex;
+    bool m_configured{false};
+    std::string m_path;
+    std::size_t m_max_file_bytes{default_max_file_bytes};
+    std::size_t m_max_files{default_max_files};
+    std::vector<uint8_t> m_buffer;
+    std::size_t m_buffer_records{0};
+    std::deque<xpending_chunk_t> m_pending;
+    std::size_t m_pending_bytes{0};
+    std::condition_variable m_pending_cv;
+    bool m_stop{false};
+    std::thread m_writer;
+
+    // owned by the writer thread
+    std::FILE * m_file{nullptr};
+    std::string m_file_path;
+    std::size_t m_file_max_bytes{default_max_file_bytes};
+    std::size_t m_file_max_files{default_max_files};
+    std::size_t m_file_bytes{0};
+};
+using xreward_audit_log_t = xtop_reward_audit_log;
+
+NS_END2
@@ -0,0 +1,169 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+NS_BEG2(top, xstake)
+
+enum class xenum_reward_audit_record_type : uint16_t {
+    invalid = 0,
+    round_issuance,  ///< issuance split of a reward round
+    round_roles,     ///< role counts of a reward round, total / valid / deposit zero per role
+    node_reward,     ///< workload, vote, self and dividend reward of one node
+    issuance_year,   ///< issuance of a year crossed since the last issuance
+    issuance,        ///< additional issuance of a reward round
+    table_reward,    ///< total reward and transferred issuance of one table contract
+    task,            ///< a dispatch task executed
+};
+using xreward_audit_record_type_t = xenum_reward_audit_record_type;
+
+/**
+ * @brief a reward amount as logged so far: whole tokens and the REWARD_PRECISION fraction.
+ *        plain integers are stored as the whole part with a zero fraction.
+ */
+struct xreward_audit_value_t {
+    uint64_t whole;
+    uint32_t fraction;
+};
+
+/**
+ * @brief one record of the reward audit log, sized by its account and value count.
+ *
+ *        file:   magic "TRWAUDIT" | uint32 version | uint32 zero | records...
+ *        record: uint16 type | uint16 account size | uint32 value count | uint64 round |
+ *                uint64 block height | uint64 execution | account | value count x (uint64 whole | uint32 fraction)
+ *        all integers are little endian. block height and execution tag the contract execution the record
+ *        was made in, a block re-executed for another proposal logs its records again under a new execution.
+ */
+struct xreward_audit_record_t {
+    static constexpr std::size_t account_capacity{96};
+    static constexpr std::size_t value_slots{16};
+    static constexpr std::size_t header_size{32};
+    static constexpr std::size_t value_size{12};
+    static constexpr std::size_t max_encoded_size{header_size + account_capacity + value_slots * value_size};
+    static constexpr uint32_t version{2};
+    static constexpr std::size_t file_header_size{16};
+
+    xreward_audit_record_type_t type{xreward_audit_record_type_t::invalid};
+    uint64_t round{0};
+    uint64_t block_height{0};
+    uint64_t execution{0};
+    std::string account;
+    uint32_t value_count{0};
+    xreward_audit_value_t values[value_slots];
+
+    /**
+     * @brief append a value, values beyond value_slots are dropped
+     *
+     */
+    void add(xreward_audit_value_t const & value) {
+        if (value_count < value_slots) {
+            values[value_count++] = value;
+        }
+    }
+
+    void add(uint64_t const value) {
+        add(xreward_audit_value_t{value, 0});
+    }
+
+    /**
+     * @brief bytes encode writes, accounts longer than account_capacity are cut
+     *
+     */
+    std::size_t encoded_size() const noexcept {
+        return header_size + (account.size() < account_capacity ? account.size() : account_capacity) + value_count * value_size;
+    }
+
+    /**
+     * @brief bytes of the record whose header_size bytes are at in
+     *
+     * @return 0 the header is malformed
+     */
+    static std::size_t encoded_size(uint8_t const * in) {
+        auto const account_size = static_cast<std::size_t>(get(in + 2, 2));
+        auto const value_count = static_cast<std::size_t>(get(in + 4, 4));
+        if (account_size > account_capacity || value_count > value_slots) {
+            return 0;
+        }
+        return header_size + account_size + value_count * value_size;
+    }
+
+    /**
+     * @brief encode to encoded_size() bytes at out
+     *
+     */
+    void encode(uint8_t * out) const {
+        auto const account_size = account.size() < account_capacity ? account.size() : account_capacity;
+        put(out + 0, static_cast<uint16_t>(type), 2);
+        put(out + 2, account_size, 2);
+        put(out + 4, value_count, 4);
+        put(out + 8, round, 8);
+        put(out + 16, block_height, 8);
+        put(out + 24, execution, 8);
+        std::memcpy(out + header_size, account.data(), account_size);
+        auto * slot = out + header_size + account_size;
+        for (std::size_t i = 0; i < value_count; ++i, slot += value_size) {
+            put(slot, values[i].whole, 8);
+            put(slot + 8, values[i].fraction, 4);
+        }
+    }
+
+    /**
+     * @brief decode the size bytes at in
+     *
+     * @return false the record is malformed
+     */
+    bool decode(uint8_t const * in, std::size_t size) {
+        if (size < header_size || encoded_size(in) != size) {
+            return false;
+        }
+        type = static_cast<xreward_audit_record_type_t>(get(in + 0, 2));
+        auto const account_size = static_cast<std::size_t>(get(in + 2, 2));
+        value_count = static_cast<uint32_t>(get(in + 4, 4));
+        round = get(in + 8, 8);
+        block_height = get(in + 16, 8);
+        execution = get(in + 24, 8);
+        account.assign(reinterpret_cast<char const *>(in + header_size), account_size);
+        auto const * slot = in + header_size + account_size;
+        for (std::size_t i = 0; i < value_count; ++i, slot += value_size) {
+            values[i].whole = get(slot, 8);
+            values[i].fraction = static_cast<uint32_t>(get(slot + 8, 4));
+        }
+        return true;
+    }
+
+    static void encode_file_header(uint8_t * out) {
+        std::memcpy(out, "TRWAUDIT", 8);
+        put(out + 8, version, 4);
+        put(out + 12, 0, 4);
+    }
+
+    static bool check_file_header(uint8_t const * in) {
+        return std::memcmp(in, "TRWAUDIT", 8) == 0 && get(in + 8, 4) == version;
+    }
+
+private:
+    static void put(uint8_t * out, uint64_t value, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    static uint64_t get(uint8_t const * in, std::size_t size) {
+        uint64_t value{0};
+        for (std::size_t i = 0; i < size; ++i) {
+            value |= static_cast<uint64_t>(in[i]) << (8 * i);
+        }
+        return value;
+    }
+};
+
+NS_END2
@@ -0,0 +1,55 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+#include "xcommon/xaddress.h"
+#include "xstake/xstake_algorithm.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+NS_BEG2(top, xstake)
+
+/**
+ * @brief params of the node reward and dividend claiming tasks: the onchain timer round followed by a
+ *        std::map<std::string, uint128_t> of account rewards, both as serialized by xstream_t.
+ *        entries are streamed straight from a reward detail map, the map count is written in front of
+ *        them once a param is full, so no string keyed copy of the map is built. that the params equal the
+ *        xstream_t encoding of the map is checked by tests/test_reward_task_params.cpp.
+ */
+class xtop_reward_task_params {
+public:
+    using rewards_t = std::map<common::xaccount_address_t, top::xstake::uint128_t>;
+    using visitor_t = std::function<void(std::string const & account, top::xstake::uint128_t const & reward)>;
+
+    xtop_reward_task_params() = delete;
+
+    /**
+     * @brief encode rewards in map order into params of at most max_accounts accounts each
+     *
+     * @param onchain_timer_round chain timer round
+     * @param rewards account rewards of one table
+     * @param max_accounts max accounts of a param
+     * @param params encoded params appended to
+     */
+    static void encode(uint64_t onchain_timer_round, rewards_t const & rewards, std::size_t max_accounts, std::vector<std::string> & params);
+
+    /**
+     * @brief visit the entries of a param in order without decoding it into a map, used for logging
+     *
+     * @param params the encoded param
+     * @param visit called for each account
+     * @return uint64_t the onchain timer round
+     */
+    static uint64_t visit(std::string const & params, visitor_t const & visit);
+};
+using xreward_task_params_t = xtop_reward_task_params;
+
+NS_END2
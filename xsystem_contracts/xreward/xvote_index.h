@@ -0,0 +1,96 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+#include "xcommon/xaddress.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+NS_BEG2(top, xstake)
+
+struct xnode_voter_tickets_t {
+    std::size_t voter{0};  // position in xvote_index_t::voters()
+    uint64_t tickets{0};
+};
+
+/**
+ * @brief votes of one reward round inverted to node => voters, built in a single pass over the tickets.
+ *        a node's total votes and the list of voters holding its tickets are found without scanning
+ *        every voter; voters keep the order of the votes detail, so sums come out in the same order.
+ */
+class xtop_vote_index {
+public:
+    xtop_vote_index() = default;
+    xtop_vote_index(xtop_vote_index const &) = delete;
+    xtop_vote_index & operator=(xtop_vote_index const &) = delete;
+    xtop_vote_index(xtop_vote_index &&) = default;
+    xtop_vote_index & operator=(xtop_vote_index &&) = default;
+    ~xtop_vote_index() = default;
+
+    /**
+     * @brief index the votes detail, replacing what was indexed before
+     *
+     * @param votes_detail voter => (node => tickets)
+     */
+    void build(std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, uint64_t>> const & votes_detail);
+
+    bool built() const noexcept;
+
+    /**
+     * @brief check if the node holds tickets of any voter, zero tickets included
+     *
+     * @param node node account
+     * @return true
+     * @return false
+     */
+    bool voted(common::xaccount_address_t const & node) const;
+
+    /**
+     * @brief total tickets of the node
+     *
+     * @param node node account
+     * @return uint64_t 0 if not voted
+     */
+    uint64_t node_total(common::xaccount_address_t const & node) const;
+
+    /**
+     * @brief the voters holding tickets of the node, in voter order
+     *
+     * @param node node account
+     * @return std::vector<xnode_voter_tickets_t> const& empty if not voted
+     */
+    std::vector<xnode_voter_tickets_t> const & node_voters(common::xaccount_address_t const & node) const;
+
+    std::vector<common::xaccount_address_t> const & voters() const noexcept;
+
+    /**
+     * @brief call visitor(node, total) for every voted node, in no particular order
+     *
+     */
+    template <typename VisitorT>
+    void for_each_node(VisitorT && visitor) const {
+        for (auto const & pair : m_nodes) {
+            visitor(pair.first, pair.second.total);
+        }
+    }
+
+private:
+    struct xnode_entry_t {
+        uint64_t total{0};
+        std::vector<xnode_voter_tickets_t> voters;
+    };
+
+    std::vector<common::xaccount_address_t> m_voters;
+    std::unordered_map<common::xaccount_address_t, xnode_entry_t> m_nodes;
+    bool m_built{false};
+};
+using xvote_index_t = xtop_vote_index;
+
+NS_END2
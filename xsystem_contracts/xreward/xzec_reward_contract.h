@@ -9,6 +9,8 @@
 #include "xvm/xcontract/xcontract_exec.h"
 #include "xdata/xtableblock.h"
 #include "xstake/xstake_algorithm.h"
+#include "xvm/xsystem_contracts/xreward/xreward_audit_log.h"
+#include "xvm/xsystem_contracts/xreward/xvote_index.h"
 
 NS_BEG2(top, xstake)
 
@@ -34,6 +36,30 @@ struct xreward_property_param_t {
     std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, uint64_t>> votes_detail;
     xaccumulated_reward_record accumulated_reward_record;
     std::map<common::xaccount_address_t, xreg_node_info> map_nodes;
+    xvote_index_t vote_index;   // votes_detail indexed by node, built with votes_detail
+};
+
+// phase times of a reward round in microseconds
+struct xreward_round_timing_t {
+    uint64_t issuance_us{0};
+    uint64_t votes_us{0};
+    uint64_t role_nums_us{0};
+    uint64_t zero_workload_us{0};
+    uint64_t node_rewards_us{0};
+    uint64_t table_rewards_us{0};
+    uint64_t dispatch_us{0};
+};
+
+struct xreward_round_result_t {
+    std::map<common::xaccount_address_t, top::xstake::uint128_t> node_reward_detail;     // <node, self reward>
+    std::map<common::xaccount_address_t, top::xstake::uint128_t> node_dividend_detail;   // <node, dividend reward>
+    top::xstake::uint128_t community_reward{0};
+    std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, top::xstake::uint128_t>> table_nodes_rewards;   // <table, <node, reward>>
+    std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, top::xstake::uint128_t>> table_vote_rewards;    // <table, <node be voted, reward>>
+    std::map<common::xaccount_address_t, top::xstake::uint128_t> contract_rewards;   // <table, total reward>
+    std::vector<std::string> tasks;     // serialized dispatch tasks, in queue order
+    uint64_t actual_issuance{0};
+    xreward_round_timing_t timing;
 };
 class xzec_reward_contract : public xcontract_base {
     using xbase_t = xcontract_base;
@@ -67,12 +93,53 @@ public:
      */
     void calculate_reward(common::xlogic_time_t timer_round, std::string const& workload_str);
 
+    /**
+     * @brief calculate one reward round from loaded params: node rewards, table rewards and dispatch tasks.
+     *        no property is read or written, so a round can be replayed offline without a contract
+     *        execution context
+     *
+     * @param current_time current time
+     * @param activation_time system activation time
+     * @param onchain_param onchain params
+     * @param property_param property params
+     * @param issue_detail record every node issuance detail
+     * @param result rewards and tasks of the round
+     */
+    void calc_reward_round(common::xlogic_time_t const current_time,
+                           common::xlogic_time_t const activation_time,
+                           xreward_onchain_param_t const & onchain_param,
+                           xreward_property_param_t & property_param,
+                           xissue_detail & issue_detail,
+                           xreward_round_result_t & result);
+
+    /**
+     * @brief decode the property values read by get_reward_param into property_param and build the vote index
+     *
+     * @param map_nodes XPORPERTY_CONTRACT_REG_KEY of the registration contract
+     * @param auditor_clusters_workloads XPORPERTY_CONTRACT_WORKLOAD_KEY
+     * @param validator_clusters_workloads XPORPERTY_CONTRACT_VALIDATOR_WORKLOAD_KEY
+     * @param contract_auditor_votes XPORPERTY_CONTRACT_TICKETS_KEY of the zec vote contract
+     * @param accumulated_record XPROPERTY_CONTRACT_ACCUMULATED_ISSUANCE_YEARLY, empty in the first year
+     * @param property_param property params
+     */
+    static void decode_reward_property(std::map<std::string, std::string> const & map_nodes,
+                                       std::map<std::string, std::string> const & auditor_clusters_workloads,
+                                       std::map<std::string, std::string> const & validator_clusters_workloads,
+                                       std::map<std::string, std::string> const & contract_auditor_votes,
+                                       std::string const & accumulated_record,
+                                       xreward_property_param_t & property_param);
+
     BEGIN_CONTRACT_WITH_PARAM(xzec_reward_contract)
         CONTRACT_FUNCTION_PARAM(xzec_reward_contract, on_timer);
         CONTRACT_FUNCTION_PARAM(xzec_reward_contract, calculate_reward);
     END_CONTRACT_WITH_PARAM
 
 private:
+    // tasks executed in one timer round
+    static constexpr std::size_t task_num_per_round{16};
+    // accounts of one claiming task made by dispatch_all_reward_v3
+    static constexpr std::size_t task_max_accounts{1000};
+
     /**
      * @brief check if we can calculate and dispatch rewards now
      *
@@ -90,25 +157,49 @@ private:
     void        reward(const common::xlogic_time_t onchain_timer_round, std::string const& workload_str);
 
     /**
-     * @brief Get the task id
+     * @brief number of dispatch tasks left
+     *
+     * @return std::size_t
+     */
+    std::size_t task_count();
+
+    /**
+     * @brief read up to count dispatch tasks in id order, the tasks are not removed
      *
-     * @return uint32_t
+     * @param count max number of tasks to read
+     * @return std::map<std::string, std::string> task ids and serialized tasks
      */
-    uint32_t    get_task_id();
+    std::map<std::string, std::string> peek_tasks(std::size_t const count);
 
     /**
-     * @brief add task
+     * @brief remove the first count of the tasks read by peek_tasks
+     *
+     * @param tasks tasks read by peek_tasks
+     * @param count number of tasks to remove
+     */
+    void remove_tasks(std::map<std::string, std::string> const & tasks, std::size_t const count);
+
+    /**
+     * @brief add dispatch tasks after the last one
+     *
+     * @param tasks serialized tasks made by make_task
+     */
+    void add_tasks(std::vector<std::string> const & tasks);
+
+    /**
+     * @brief make a task
      *
-     * @param task_id task id
      * @param onchain_timer_round chain timer round
      * @param contract contract address
      * @param action action to execute
      * @param params action parameters
+     * @return std::string the serialized task to enqueue
      */
-    void        add_task(const uint32_t task_id, const uint64_t onchain_timer_round, const std::string &contract, const std::string &action, const std::string &params);
+    static std::string make_task(const uint64_t onchain_timer_round, const std::string &contract, const std::string &action, const std::string &params);
 
     /**
-     * @brief execute all tasks
+     * @brief execute up to task_num_per_round tasks in id order, the output txs and param bytes
+     *        of the round are reported
      *
      */
     void        execute_task();
@@ -224,8 +315,9 @@ private:
      * @param auditor
      * @param cluster_id
      * @param leader_count
+     * @return std::size_t bytes of the cluster workload written back
      */
-    void        add_cluster_workload(bool auditor, std::string const& cluster_id, std::map<std::string, uint32_t> const& leader_count);
+    std::size_t add_cluster_workload(bool auditor, std::string const& cluster_id, std::map<std::string, uint32_t> const& leader_count);
 
     /**
      * @brief clear workload
@@ -267,6 +359,7 @@ private:
      * @param node_reward_detail record self reward of accounts
      * @param node_dividend_detail record dividend reward of accounts
      * @param community_reward record community reward to transfer
+     * @param timing phase times of the calculation
      */
     void calc_nodes_rewards_v5(common::xlogic_time_t const current_time,
                                common::xlogic_time_t const issue_time_length,
@@ -275,7 +368,8 @@ private:
                                xissue_detail & issue_detail,
                                std::map<common::xaccount_address_t, top::xstake::uint128_t> & node_reward_detail,
                                std::map<common::xaccount_address_t, top::xstake::uint128_t> & node_dividend_detail,
-                               top::xstake::uint128_t & community_reward);
+                               top::xstake::uint128_t & community_reward,
+                               xreward_round_timing_t & timing);
 
     /**
      * @brief calculate every table rewards
@@ -295,7 +389,7 @@ private:
                             std::map<common::xaccount_address_t, top::xstake::uint128_t> & table_total_rewards);
 
     /**
-     * @brief dispatch all reward calculated in calc_nodes_rewards
+     * @brief make the dispatch tasks of all reward calculated in calc_nodes_rewards, the tasks are enqueued by the caller
      *
      * @param current_time current time
      * @param table_total_rewards record to transfer calculated in calc_nodes_rewards
@@ -303,13 +397,15 @@ private:
      * @param table_node_dividend_detail dividend reward detail calculated in calc_nodes_rewards
      * @param community_reward community reward calculated in calc_nodes_rewards
      * @param actual_issuance actual issuance this time
+     * @param tasks serialized tasks, in queue order
      */
     void dispatch_all_reward_v3(const common::xlogic_time_t current_time,
                                 std::map<common::xaccount_address_t, top::xstake::uint128_t> & table_total_rewards,
                                 std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, top::xstake::uint128_t>> & table_node_reward_detail,
                                 std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, top::xstake::uint128_t>> & table_node_dividend_detail,
                                 top::xstake::uint128_t & community_reward,
-                                uint64_t & actual_issuance);
+                                uint64_t & actual_issuance,
+                                std::vector<std::string> & tasks);
 
     /**
      * @brief update property
@@ -365,6 +461,27 @@ private:
     std::map<common::xaccount_address_t, uint64_t> calc_votes(std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, uint64_t>> const & votes_detail,
                                                               std::map<common::xaccount_address_t, xreg_node_info> const & map_nodes);
 
+    /**
+     * @brief set votes into map_nodes and calculate total valid auditor votes, from the vote index
+     *
+     * @param vote_index votes detail indexed by node
+     * @param map_nodes nodes detail
+     * @param account_votes vote of every node in this round
+     * @return total valid auditor votes
+     */
+    uint64_t calc_votes(xvote_index_t const & vote_index,
+                        std::map<common::xaccount_address_t, xreg_node_info> & map_nodes,
+                        std::map<common::xaccount_address_t, uint64_t> & account_votes);
+
+    /**
+     * @brief caculate vote of every node in this round, from the vote index
+     *
+     * @param vote_index votes detail indexed by node
+     * @param map_nodes nodes detail
+     * @return account_votes vote of every node in this round
+     */
+    std::map<common::xaccount_address_t, uint64_t> calc_votes(xvote_index_t const & vote_index, std::map<common::xaccount_address_t, xreg_node_info> const & map_nodes);
+
     /**
      * @brief calculate zero workload reward
      *
@@ -496,6 +613,25 @@ private:
                                          std::map<common::xaccount_address_t, top::xstake::uint128_t> & table_total_rewards,
                                          std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, top::xstake::uint128_t>> & table_node_dividend_detail);
 
+    /**
+     * @brief record dividend reward of one voter
+     *
+     * @param table_address address of voter table contract
+     * @param account node account
+     * @param reward account dividend reward
+     * @param node_total_votes node total votes
+     * @param voter_tickets tickets of the voter on the node
+     * @param table_total_rewards add node self reward into table
+     * @param table_node_dividend_detail record node dividend reward into table detail
+     */
+    void calc_table_node_dividend(common::xaccount_address_t const & table_address,
+                                  common::xaccount_address_t const & account,
+                                  top::xstake::uint128_t const & reward,
+                                  uint64_t node_total_votes,
+                                  uint64_t voter_tickets,
+                                  std::map<common::xaccount_address_t, top::xstake::uint128_t> & table_total_rewards,
+                                  std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, top::xstake::uint128_t>> & table_node_dividend_detail);
+
     /**
      * @brief calculate table contract address
      *
@@ -503,6 +639,9 @@ private:
      * @return address
      */
     common::xaccount_address_t calc_table_contract_address(common::xaccount_address_t const & account);
+
+    // execution the audit records of this instance are tagged with, numbered in on_timer
+    xreward_audit_execution_t m_audit_execution;
 };
 
 NS_END2